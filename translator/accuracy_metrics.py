@@ -1,10 +1,20 @@
 """
 Accuracy metrics: Run 20 diverse test programs through all 4 translation 
 directions and report compile success rate.
+
+The matrix cells are fully independent, so they run concurrently
+(--jobs N, default one per core), and each cell result is cached in
+.metrics_cache.json keyed by program source + the backend's dependency
+closure (snapshot_hash.closure_digest) + verify.py, so re-runs only
+re-measure directions whose translator actually changed. ERROR cells
+are never cached: they usually mean a transient environment problem,
+not a property of the translator.
 """
-import sys, os, tempfile
+import sys, os, tempfile, json, hashlib, concurrent.futures
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'src'))
 import c_to_java, java_to_c, c_to_cpp, cpp_to_c
+import snapshot_hash
+import verify
 from verify import compile_c_wsl, compile_java_wsl, compile_cpp_wsl
 
 # ─── 10 C programs ─────────────────────────────────────────────────────────
@@ -77,94 +87,135 @@ CPP_PROGRAMS = {
 }
 
 
-def run_metrics():
-    results = []
+CACHE_PATH = os.path.join(os.path.dirname(__file__), '.metrics_cache.json')
 
-    # C -> Java
-    print("=" * 60)
-    print("  C -> Java (10 programs)")
-    print("=" * 60)
-    for name, src in C_PROGRAMS.items():
-        try:
+
+def _file_hash(path):
+    with open(path, 'rb') as f:
+        return hashlib.sha256(f.read()).hexdigest()
+
+
+def _cell_key(direction, src, backend_module):
+    h = hashlib.sha256()
+    h.update(direction.encode())
+    h.update(src.encode())
+    # The backend's whole dependency closure, not just its own file:
+    # C-side output also flows through rules.py, ast_cache.py,
+    # preprocess.py and fake_headers/ (same fix as snapshot pair_hash)
+    h.update(snapshot_hash.closure_digest(backend_module.__name__).encode())
+    h.update(_file_hash(verify.__file__).encode())
+    return h.hexdigest()
+
+
+def _run_cell(direction, name, src):
+    """Translate + compile-verify one matrix cell; returns PASS/FAIL/ERROR."""
+    try:
+        if direction == 'C->Java' or direction == 'C->C++':
             # Write to temp file for pycparser
-            with tempfile.NamedTemporaryFile(suffix='.c', mode='w', 
-                                             encoding='utf-8', delete=False) as f:
-                f.write(src); tmp = f.name
-            java_out = c_to_java.translate_file(tmp)
-            os.unlink(tmp)
-            ok, msg = compile_java_wsl(java_out)
-            status = "PASS" if ok else "FAIL"
-        except Exception as e:
-            status = "ERROR"
-            msg = str(e)[:50]
-        results.append(("C->Java", name, status))
-        print(f"  {status:5s}  {name}")
-
-    # C -> C++
-    print("\n" + "=" * 60)
-    print("  C -> C++ (10 programs)")
-    print("=" * 60)
-    for name, src in C_PROGRAMS.items():
-        try:
             with tempfile.NamedTemporaryFile(suffix='.c', mode='w',
                                              encoding='utf-8', delete=False) as f:
                 f.write(src); tmp = f.name
-            cpp_out = c_to_cpp.translate_file(tmp)
-            os.unlink(tmp)
-            ok, msg = compile_cpp_wsl(cpp_out)
-            status = "PASS" if ok else "FAIL"
-        except Exception as e:
-            status = "ERROR"
-            msg = str(e)[:50]
-        results.append(("C->C++", name, status))
-        print(f"  {status:5s}  {name}")
-
-    # Java -> C
-    print("\n" + "=" * 60)
-    print("  Java -> C (10 programs)")
-    print("=" * 60)
-    for name, src in JAVA_PROGRAMS.items():
-        try:
-            c_out = java_to_c.translate_string(src)
-            ok, msg = compile_c_wsl(c_out)
-            status = "PASS" if ok else "FAIL"
-        except Exception as e:
-            status = "ERROR"
-            msg = str(e)[:50]
-        results.append(("Java->C", name, status))
-        print(f"  {status:5s}  {name}")
-
-    # C++ -> C
-    print("\n" + "=" * 60)
-    print("  C++ -> C (10 programs)")
-    print("=" * 60)
-    for name, src in CPP_PROGRAMS.items():
+            if direction == 'C->Java':
+                out = c_to_java.translate_file(tmp)
+                os.unlink(tmp)
+                ok, msg = compile_java_wsl(out)
+            else:
+                out = c_to_cpp.translate_file(tmp)
+                os.unlink(tmp)
+                ok, msg = compile_cpp_wsl(out)
+        elif direction == 'Java->C':
+            out = java_to_c.translate_string(src)
+            ok, msg = compile_c_wsl(out)
+        else:  # C++->C
+            out = cpp_to_c.translate_string(src)
+            ok, msg = compile_c_wsl(out)
+        return 'PASS' if ok else 'FAIL'
+    except Exception:
+        return 'ERROR'
+
+
+MATRIX = [
+    ('C->Java', C_PROGRAMS, c_to_java),
+    ('C->C++',  C_PROGRAMS, c_to_cpp),
+    ('Java->C', JAVA_PROGRAMS, java_to_c),
+    ('C++->C',  CPP_PROGRAMS, cpp_to_c),
+]
+
+
+def run_metrics(jobs=None):
+    jobs = jobs or os.cpu_count() or 4
+    try:
+        with open(CACHE_PATH, encoding='utf-8') as f:
+            cache = json.load(f)
+    except (OSError, ValueError):
+        cache = {}
+
+    cells = []       # (direction, name, src, key)
+    results = {}     # (direction, name) -> status
+    for direction, programs, backend in MATRIX:
+        for name, src in programs.items():
+            key = _cell_key(direction, src, backend)
+            if key in cache:
+                results[(direction, name)] = cache[key] + ' (cached)'
+            else:
+                cells.append((direction, name, src, key))
+
+    if cells:
+        print(f'Measuring {len(cells)} cells on {jobs} workers '
+              f'({len(results)} cached)...')
+        with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+            futures = {pool.submit(_run_cell, d, n, src): (d, n, key)
+                       for d, n, src, key in cells}
+            for fut in concurrent.futures.as_completed(futures):
+                direction, name, key = futures[fut]
+                status = fut.result()
+                results[(direction, name)] = status
+                # ERROR usually means a transient environment failure
+                # (missing compiler, dead WSL); caching it would pin the
+                # bad verdict forever
+                if status != 'ERROR':
+                    cache[key] = status
         try:
-            c_out = cpp_to_c.translate_string(src)
-            ok, msg = compile_c_wsl(c_out)
-            status = "PASS" if ok else "FAIL"
-        except Exception as e:
-            status = "ERROR"
-            msg = str(e)[:50]
-        results.append(("C++->C", name, status))
-        print(f"  {status:5s}  {name}")
+            with open(CACHE_PATH, 'w', encoding='utf-8') as f:
+                json.dump(cache, f, indent=2, sort_keys=True)
+        except OSError:
+            pass
+
+    flat = []
+    for direction, programs, _ in MATRIX:
+        print('\n' + '=' * 60)
+        print(f'  {direction} ({len(programs)} programs)')
+        print('=' * 60)
+        for name in programs:
+            status = results[(direction, name)]
+            print(f'  {status.split()[0]:5s}  {name}'
+                  + ('  (cached)' if status.endswith('(cached)') else ''))
+            flat.append((direction, name, status.split()[0]))
 
     # Summary
-    print("\n" + "=" * 60)
-    print("  ACCURACY SUMMARY")
-    print("=" * 60)
-    for direction in ["C->Java", "C->C++", "Java->C", "C++->C"]:
-        dir_results = [r for r in results if r[0] == direction]
-        passed = sum(1 for r in dir_results if r[2] == "PASS")
+    print('\n' + '=' * 60)
+    print('  ACCURACY SUMMARY')
+    print('=' * 60)
+    import metrics_history
+    for direction in ['C->Java', 'C->C++', 'Java->C', 'C++->C']:
+        dir_results = [r for r in flat if r[0] == direction]
+        passed = sum(1 for r in dir_results if r[2] == 'PASS')
         total = len(dir_results)
         pct = (passed / total * 100) if total > 0 else 0
-        print(f"  {direction:10s}: {passed}/{total} ({pct:.0f}%)")
+        print(f'  {direction:10s}: {passed}/{total} ({pct:.0f}%)')
+        metrics_history.append_record('accuracy', {
+            'direction': direction, 'passed': passed, 'total': total})
 
-    total_pass = sum(1 for r in results if r[2] == "PASS")
-    total = len(results)
+    total_pass = sum(1 for r in flat if r[2] == 'PASS')
+    total = len(flat)
     pct = (total_pass / total * 100) if total > 0 else 0
     print(f"  {'OVERALL':10s}: {total_pass}/{total} ({pct:.0f}%)")
 
 
 if __name__ == '__main__':
-    run_metrics()
+    jobs = None
+    if '--jobs' in sys.argv:
+        idx = sys.argv.index('--jobs')
+        if idx + 1 < len(sys.argv):
+            jobs = max(1, int(sys.argv[idx + 1]))
+    run_metrics(jobs)
@@ -0,0 +1,164 @@
+"""
+Scaling benchmarks: generate synthetic C / C++ / Java programs at
+1k/10k/100k lines and measure how each translator backend scales.
+
+The samples/ corpus tops out at toy programs, so superlinear blowups in
+the visitor hot loops only showed up in production. The generators here
+stress the known shapes: wide function counts, deep expression nesting,
+and large switch tables. Each cell runs in a fresh subprocess so peak
+RSS is measured per run, and the report shows wall time, peak RSS and
+throughput in lines/sec.
+
+Usage:
+    uv run python benchmark_scaling.py [--sizes 1000,10000,100000]
+"""
+import sys, os, time, concurrent.futures
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'src'))
+
+DEFAULT_SIZES = [1000, 10000, 100000]
+
+
+# ─── synthetic program generators ──────────────────────────────────────────
+
+def _deep_expr(depth, var='x'):
+    """Nested arithmetic: ((x + 1) * (x + 2)) * ... to stress emitters."""
+    e = var
+    for i in range(depth):
+        e = f'({e} + {i % 7}) * ({var} - {i % 5})'
+    return e
+
+
+def gen_c(target_lines):
+    """Include-free C: wide function count, deep expressions, big switch."""
+    lines = []
+    n_funcs = max(1, target_lines // 8)
+    for i in range(n_funcs):
+        lines.append(f'int f{i}(int x) {{')
+        lines.append(f'    int a = {_deep_expr(6)};')
+        lines.append(f'    if (a > {i}) {{ a = a - {i}; }}')
+        lines.append(f'    switch (x % 4) {{')
+        lines.append(f'        case 0: a = a + 1; break;')
+        lines.append(f'        case 1: a = a - 1; break;')
+        lines.append(f'        default: a = 0;')
+        lines.append(f'    }}')
+        lines.append(f'    return a;')
+        lines.append(f'}}')
+    lines.append('int main() {')
+    lines.append('    int total = 0;')
+    lines.append(f'    total = total + f0(3);')
+    lines.append('    return 0;')
+    lines.append('}')
+    return '\n'.join(lines)
+
+
+def gen_cpp(target_lines):
+    """C++ with iostreams, bools and casts over many functions."""
+    lines = ['#include <iostream>', 'using namespace std;']
+    n_funcs = max(1, target_lines // 9)
+    for i in range(n_funcs):
+        lines.append(f'int g{i}(int x) {{')
+        lines.append(f'    bool flag = x > {i};')
+        lines.append(f'    int a = {_deep_expr(6)};')
+        lines.append(f'    if (flag) {{')
+        lines.append(f'        a = static_cast<int>(a * 1.5);')
+        lines.append(f'    }} else {{')
+        lines.append(f'        a = 0;')
+        lines.append(f'    }}')
+        lines.append(f'    cout << a << endl;')
+        lines.append(f'    return a;')
+        lines.append(f'}}')
+    lines.append('int main() { return g0(2); }')
+    return '\n'.join(lines)
+
+
+def gen_java(target_lines):
+    """Java: one class, many static methods, switch tables."""
+    lines = ['public class Main {']
+    n_funcs = max(1, target_lines // 10)
+    for i in range(n_funcs):
+        lines.append(f'    static int m{i}(int x) {{')
+        lines.append(f'        int a = {_deep_expr(6)};')
+        lines.append(f'        switch (x % 3) {{')
+        lines.append(f'            case 0: a = a + 1; break;')
+        lines.append(f'            case 1: a = a - 1; break;')
+        lines.append(f'            default: a = 0;')
+        lines.append(f'        }}')
+        lines.append(f'        while (a > {i + 1}) {{')
+        lines.append(f'            a = a / 2;')
+        lines.append(f'        }}')
+        lines.append(f'        return a;')
+        lines.append(f'    }}')
+    lines.append('    public static void main(String[] args) {')
+    lines.append('        System.out.println(m0(5));')
+    lines.append('    }')
+    lines.append('}')
+    return '\n'.join(lines)
+
+
+BACKENDS = [
+    # (direction label, generator, translator module, entry point)
+    ('Java->C',  gen_java, 'java_to_c', 'translate_string'),
+    ('C->Java',  gen_c,    'c_to_java', 'translate_string'),
+    ('C->C++',   gen_c,    'c_to_cpp',  'translate_string'),
+    ('C++->C',   gen_cpp,  'cpp_to_c',  'translate_string'),
+]
+
+
+def _measure(module_name, entry, source):
+    """Runs in a fresh subprocess: translate once, report time and RSS.
+    RSS is None where the resource module is unavailable (Windows)."""
+    import importlib
+    try:
+        import resource
+    except ImportError:
+        resource = None
+    mod = importlib.import_module(module_name)
+    fn = getattr(mod, entry)
+    t0 = time.perf_counter()
+    fn(source)
+    elapsed = time.perf_counter() - t0
+    rss_kb = (resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+              if resource is not None else None)
+    return elapsed, rss_kb
+
+
+def run_benchmarks(sizes):
+    records = []
+    print(f'  {"Direction":<10} {"Lines":>8} {"Time":>9} '
+          f'{"Lines/sec":>10} {"Peak RSS":>10}')
+    print(f'  {"-"*10} {"-"*8} {"-"*9} {"-"*10} {"-"*10}')
+    for direction, gen, module_name, entry in BACKENDS:
+        for size in sizes:
+            source = gen(size)
+            n_lines = source.count('\n') + 1
+            # Fresh subprocess per cell so ru_maxrss is per-run.
+            with concurrent.futures.ProcessPoolExecutor(max_workers=1) as pool:
+                try:
+                    elapsed, rss_kb = pool.submit(
+                        _measure, module_name, entry, source).result()
+                except Exception as e:
+                    print(f'  {direction:<10} {n_lines:>8} '
+                          f'ERROR: {str(e)[:40]}')
+                    continue
+            lps = n_lines / elapsed if elapsed > 0 else 0
+            rss_str = (f'{rss_kb / 1024:>8.1f}MB' if rss_kb is not None
+                       else f'{"n/a":>10}')
+            print(f'  {direction:<10} {n_lines:>8} {elapsed:>8.2f}s '
+                  f'{lps:>10.0f} {rss_str}')
+            records.append({'direction': direction, 'lines': n_lines,
+                            'seconds': round(elapsed, 4),
+                            'lines_per_sec': round(lps, 1),
+                            'peak_rss_kb': rss_kb})
+    return records
+
+
+if __name__ == '__main__':
+    sizes = DEFAULT_SIZES
+    if '--sizes' in sys.argv:
+        idx = sys.argv.index('--sizes')
+        if idx + 1 < len(sys.argv):
+            sizes = [int(x) for x in sys.argv[idx + 1].split(',')]
+    records = run_benchmarks(sizes)
+    import metrics_history
+    for r in records:
+        metrics_history.append_record('benchmark', r)
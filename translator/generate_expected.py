@@ -1,10 +1,18 @@
-"""Generate all snapshot expected files from current translator output."""
-import sys, os
+"""Generate all snapshot expected files from current translator output.
+
+Pairs regenerate in parallel (one process each), and a hash of each
+pair's inputs is recorded in tests/expected/.snapshot_hashes.json so
+test_snapshots.py can skip re-translating pairs that provably haven't
+changed.
+"""
+import sys, os, json, concurrent.futures
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'src'))
 import java_to_c, c_to_java
+from snapshot_hash import pair_hash
 
 SAMPLES  = os.path.join(os.path.dirname(__file__), 'samples')
 EXPECTED = os.path.join(os.path.dirname(__file__), 'tests', 'expected')
+HASHES   = os.path.join(EXPECTED, '.snapshot_hashes.json')
 
 pairs = [
     ('fibonacci.java',       'fibonacci_j2c.expected',       'j2c'),
@@ -14,7 +22,9 @@ pairs = [
     ('hashmap_strings.java', 'hashmap_strings_j2c.expected', 'j2c'),
 ]
 
-for src, exp, direction in pairs:
+
+def regenerate(pair):
+    src, exp, direction = pair
     path = os.path.join(SAMPLES, src)
     if direction == 'j2c':
         out = java_to_c.translate_file(path)
@@ -23,6 +33,17 @@ for src, exp, direction in pairs:
     exp_path = os.path.join(EXPECTED, exp)
     with open(exp_path, 'w', encoding='utf-8') as f:
         f.write(out)
-    print(f"  [OK] {src:30s} -> {exp} ({len(out)} chars)")
+    return src, exp, direction, len(out)
+
+
+if __name__ == '__main__':
+    hashes = {}
+    with concurrent.futures.ProcessPoolExecutor() as pool:
+        for src, exp, direction, size in pool.map(regenerate, pairs):
+            hashes[exp] = pair_hash(src, exp, direction)
+            print(f"  [OK] {src:30s} -> {exp} ({size} chars)")
+
+    with open(HASHES, 'w', encoding='utf-8') as f:
+        json.dump(hashes, f, indent=2, sort_keys=True)
 
-print(f"\nGenerated {len(pairs)} expected files.")
+    print(f"\nGenerated {len(pairs)} expected files.")
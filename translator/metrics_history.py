@@ -0,0 +1,88 @@
+"""
+Metrics history: timestamped baseline tracking for benchmark and
+accuracy runs, plus a comparison mode that flags regressions.
+
+metrics_output.txt was a one-off dump with no history, so hot-loop
+performance regressions landed silently. benchmark_scaling.py and
+accuracy_metrics.py now append one NDJSON record per measurement here;
+--check compares each metric's latest record against its previous one
+and flags cells that regressed beyond the threshold.
+
+Usage:
+    uv run python metrics_history.py --check [--threshold 0.15]
+"""
+import sys, os, json, time
+
+HISTORY = os.path.join(os.path.dirname(__file__), 'metrics_history.ndjson')
+
+DEFAULT_THRESHOLD = 0.15   # 15% slower / lower pass rate counts as regression
+
+
+def append_record(kind, record):
+    """Append one timestamped measurement. kind: 'benchmark' | 'accuracy'."""
+    rec = {'ts': time.strftime('%Y-%m-%dT%H:%M:%S'), 'kind': kind}
+    rec.update(record)
+    try:
+        with open(HISTORY, 'a', encoding='utf-8') as f:
+            f.write(json.dumps(rec) + '\n')
+    except OSError:
+        pass  # history is best-effort; never fail a run over it
+
+
+def _key(rec):
+    # One metric series per direction (and per input size for benchmarks).
+    return (rec['kind'], rec.get('direction'), rec.get('lines'))
+
+
+def check(threshold=DEFAULT_THRESHOLD):
+    """Compare each metric's latest record to its previous one.
+
+    Returns the number of regressions found (also printed)."""
+    try:
+        with open(HISTORY, encoding='utf-8') as f:
+            records = [json.loads(l) for l in f if l.strip()]
+    except OSError:
+        print(f'No history at {HISTORY}; run the benchmarks first.')
+        return 0
+
+    series = {}
+    for rec in records:
+        series.setdefault(_key(rec), []).append(rec)
+
+    regressions = 0
+    for key, recs in sorted(series.items(), key=lambda kv: str(kv[0])):
+        if len(recs) < 2:
+            continue
+        prev, last = recs[-2], recs[-1]
+        kind, direction, lines = key
+        label = f'{direction}' + (f' @{lines} lines' if lines else '')
+
+        if kind == 'benchmark':
+            p, l = prev.get('seconds'), last.get('seconds')
+            if p and l and l > p * (1 + threshold):
+                print(f'  REGRESSION  {label}: {p:.2f}s -> {l:.2f}s '
+                      f'(+{(l / p - 1) * 100:.0f}%)')
+                regressions += 1
+        elif kind == 'accuracy':
+            p = prev.get('passed', 0) / max(prev.get('total', 1), 1)
+            l = last.get('passed', 0) / max(last.get('total', 1), 1)
+            if l < p - threshold:
+                print(f'  REGRESSION  {label}: pass rate '
+                      f'{p * 100:.0f}% -> {l * 100:.0f}%')
+                regressions += 1
+
+    if regressions == 0:
+        print(f'  No regressions beyond {threshold * 100:.0f}% '
+              f'across {len(series)} metric series.')
+    return regressions
+
+
+if __name__ == '__main__':
+    threshold = DEFAULT_THRESHOLD
+    if '--threshold' in sys.argv:
+        idx = sys.argv.index('--threshold')
+        if idx + 1 < len(sys.argv):
+            threshold = float(sys.argv[idx + 1])
+    if '--check' in sys.argv:
+        sys.exit(1 if check(threshold) else 0)
+    print(__doc__)
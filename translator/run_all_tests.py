@@ -1,6 +1,13 @@
 #!/usr/bin/env python3
-"""Run all samples through translators + compiler verification."""
-import sys, os
+"""Run all samples through translators + compiler verification.
+
+Samples are independent of each other, so they run concurrently
+(--jobs N, default one worker per core). The compile checks are
+subprocess-bound, so threads are enough to keep every core busy, and
+each verification works in its own temp file so parallel compiles
+don't collide.
+"""
+import sys, os, concurrent.futures
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'src'))
 
 import java_to_c, c_to_java
@@ -8,42 +15,52 @@ from verify import compile_c_wsl, compile_java_wsl
 
 SAMPLES = os.path.join(os.path.dirname(__file__), 'samples')
 
-results = []
+jobs = os.cpu_count() or 4
+if '--jobs' in sys.argv:
+    idx = sys.argv.index('--jobs')
+    if idx + 1 < len(sys.argv):
+        jobs = max(1, int(sys.argv[idx + 1]))
+
 
-# Java -> C samples
-for fname in sorted(os.listdir(SAMPLES)):
+def check_sample(fname):
+    """Translate + compile-verify one sample; returns a result tuple."""
     path = os.path.join(SAMPLES, fname)
     if fname.endswith('.java'):
+        direction, translate, compile_out = 'java->c', java_to_c.translate_file, compile_c_wsl
+    else:
+        direction, translate, compile_out = 'c->java', c_to_java.translate_file, compile_java_wsl
+    try:
+        code = translate(path)
+        ok, msg = compile_out(code)
+        status = 'PASS' if ok else 'FAIL'
+        return (fname, direction, status, msg[:100], len(code))
+    except Exception as e:
+        return (fname, direction, 'ERROR', str(e)[:100], 0)
+
+
+samples = [f for f in sorted(os.listdir(SAMPLES))
+           if f.endswith(('.java', '.c'))]
+
+print(f'Running {len(samples)} samples on {jobs} workers...')
+
+results = []
+with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+    futures = {pool.submit(check_sample, f): f for f in samples}
+    for fut in concurrent.futures.as_completed(futures):
+        fname, direction, status, msg, size = fut.result()
         print(f'\n{"="*50}')
-        print(f'  Java->C: {fname}')
-        print(f'{"="*50}')
-        try:
-            c_code = java_to_c.translate_file(path)
-            print(f'  [OK] Translated ({len(c_code)} chars)')
-            ok, msg = compile_c_wsl(c_code)
-            status = 'PASS' if ok else 'FAIL'
-            print(f'  gcc [{status}]: {msg[:150]}')
-            results.append((fname, 'java->c', status, msg[:100]))
-        except Exception as e:
-            print(f'  [ERROR] {e}')
-            results.append((fname, 'java->c', 'ERROR', str(e)[:100]))
-
-    elif fname.endswith('.c'):
-        print(f'\n{"="*50}')
-        print(f'  C->Java: {fname}')
+        print(f'  {direction}: {fname}')
         print(f'{"="*50}')
-        try:
-            java_code = c_to_java.translate_file(path)
-            print(f'  [OK] Translated ({len(java_code)} chars)')
-            ok, msg = compile_java_wsl(java_code)
-            status = 'PASS' if ok else 'FAIL'
-            print(f'  javac [{status}]: {msg[:150]}')
-            results.append((fname, 'c->java', status, msg[:100]))
-        except Exception as e:
-            print(f'  [ERROR] {e}')
-            results.append((fname, 'c->java', 'ERROR', str(e)[:100]))
-
-# Summary
+        if status == 'ERROR':
+            print(f'  [ERROR] {msg}')
+        else:
+            print(f'  [OK] Translated ({size} chars)')
+            tool = 'gcc' if direction == 'java->c' else 'javac'
+            print(f'  {tool} [{status}]: {msg[:150]}')
+        results.append((fname, direction, status, msg))
+
+# Summary (back in sample order, regardless of completion order)
+results.sort(key=lambda r: samples.index(r[0]))
 print(f'\n\n{"="*50}')
 print(f'  SUMMARY')
 print(f'{"="*50}')
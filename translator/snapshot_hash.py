@@ -0,0 +1,63 @@
+"""Shared input hashing for snapshot tests and regeneration.
+
+A snapshot's output can only change if the sample, the expected file, or
+any module in the translator's dependency closure for that direction
+changed. Hashing just the backend module is not enough: c_to_java's
+output also flows through the shared rule engine, the AST cache, and the
+bundled preprocessor with its fake headers. pair_hash() digests the
+whole closure, so both test_snapshots.py and generate_expected.py agree
+on when a pair is provably up to date.
+"""
+import os, hashlib
+
+_HERE     = os.path.dirname(__file__)
+_SRC      = os.path.join(_HERE, 'src')
+SAMPLES   = os.path.join(_HERE, 'samples')
+EXPECTED  = os.path.join(_HERE, 'tests', 'expected')
+
+# Per-backend dependency closure: the backend module plus every module
+# (and header directory) it pulls output-affecting behavior from. Shared
+# with accuracy_metrics, which has the same staleness problem for its
+# per-cell cache.
+_CLOSURES = {
+    'java_to_c': ('java_to_c.py',),
+    'c_to_java': ('c_to_java.py', 'rules.py', 'ast_cache.py',
+                  'preprocess.py'),
+    'c_to_cpp':  ('c_to_cpp.py', 'rules.py', 'ast_cache.py',
+                  'preprocess.py'),
+    'cpp_to_c':  ('cpp_to_c.py',),
+}
+_CLOSURE_DIRS = {
+    'c_to_java': ('fake_headers',),
+    'c_to_cpp':  ('fake_headers',),
+}
+
+# Snapshot directions map onto backend closures
+_DIRECTION_BACKEND = {'j2c': 'java_to_c', 'c2j': 'c_to_java'}
+
+
+def _read(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def closure_digest(backend):
+    """Digest of every source file that can change the named backend's
+    output (its module, shared engines, bundled headers)."""
+    h = hashlib.sha256()
+    for name in _CLOSURES[backend]:
+        h.update(_read(os.path.join(_SRC, name)))
+    for dirname in _CLOSURE_DIRS.get(backend, ()):
+        d = os.path.join(_SRC, dirname)
+        for name in sorted(os.listdir(d)):
+            h.update(name.encode('utf-8'))
+            h.update(_read(os.path.join(d, name)))
+    return h.hexdigest()
+
+
+def pair_hash(sample, expected, direction):
+    h = hashlib.sha256()
+    h.update(_read(os.path.join(SAMPLES, sample)))
+    h.update(closure_digest(_DIRECTION_BACKEND[direction]).encode('utf-8'))
+    h.update(_read(os.path.join(EXPECTED, expected)))
+    return h.hexdigest()
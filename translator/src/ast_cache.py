@@ -0,0 +1,82 @@
+# =============================================================================
+#  ast_cache.py  -- shared on-disk pycparser AST cache
+#
+#  Both c_to_java.py and c_to_cpp.py parse the same C inputs (the --to cpp
+#  and default C->Java runs go back-to-back over the same tree), and parsing
+#  -- including the external gcc -E preprocessor pass -- is ~60% of C-side
+#  translation time. This module pickles each parsed c_ast keyed by a hash
+#  of the preprocessed text (or the string input) plus the pycparser
+#  version, so the second direction and repeat runs skip the parse; the
+#  file path still runs gcc -E so header edits are always observed.
+#
+#  The cache lives in one shared directory (overridable via the
+#  C2JAVA_AST_CACHE env var) and is strictly best-effort: any read or write
+#  failure falls through to a normal parse.
+# =============================================================================
+
+import sys, os, hashlib, pickle, tempfile
+
+sys.path.insert(0, os.path.dirname(__file__))
+
+import pycparser
+
+CACHE_DIR = os.environ.get(
+    'C2JAVA_AST_CACHE',
+    os.path.join(tempfile.gettempdir(), 'c2java_ast_cache'))
+
+_VERSION = getattr(pycparser, '__version__', '?')
+
+
+def _key(data: bytes, tag: str) -> str:
+    h = hashlib.sha256()
+    h.update(data)
+    h.update(tag.encode('utf-8'))
+    h.update(_VERSION.encode('utf-8'))
+    return h.hexdigest()
+
+
+def _load(key: str):
+    try:
+        with open(os.path.join(CACHE_DIR, key + '.pkl'), 'rb') as f:
+            return pickle.load(f)
+    except (OSError, pickle.UnpicklingError, EOFError, AttributeError):
+        return None
+
+
+def _store(key: str, ast):
+    try:
+        os.makedirs(CACHE_DIR, exist_ok=True)
+        path = os.path.join(CACHE_DIR, key + '.pkl')
+        tmp = path + f'.{os.getpid()}.tmp'
+        with open(tmp, 'wb') as f:
+            pickle.dump(ast, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmp, path)   # atomic: parallel workers may race here
+    except (OSError, pickle.PicklingError):
+        pass
+
+
+def parse_file(c_path: str, cpp_args):
+    """pycparser.parse_file with caching. The preprocessor always runs;
+    only the parse is cached, keyed on the preprocessed text. Keying the
+    raw .c bytes would serve a stale AST forever after a header-only
+    edit, since gcc -E expands project headers whose contents the raw
+    bytes don't see. Raises like the original on a preprocess or parse
+    failure; failures are never cached."""
+    text = pycparser.preprocess_file(c_path, cpp_path='gcc',
+                                     cpp_args=cpp_args)
+    key = _key(text.encode('utf-8'), 'file')
+    ast = _load(key)
+    if ast is None:
+        ast = pycparser.CParser().parse(text, filename=c_path)
+        _store(key, ast)
+    return ast
+
+
+def parse_string(source: str):
+    """pycparser.CParser().parse with caching, for preprocessed source."""
+    key = _key(source.encode('utf-8'), 'string')
+    ast = _load(key)
+    if ast is None:
+        ast = pycparser.CParser().parse(source, filename='<string>')
+        _store(key, ast)
+    return ast
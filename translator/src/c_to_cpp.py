@@ -16,8 +16,11 @@
 #    function pointers -> std::function
 # =============================================================================
 
+import threading
+
 import pycparser
 from pycparser import c_ast
+import rules
 
 TYPE_MAP = {
     'int':'int','float':'float','double':'double','char':'char',
@@ -31,8 +34,10 @@ MATH_FUNCS = {
     'ceil','floor','round','log','log10','exp','abs','fabs','fmax','fmin',
 }
 
+_TYPE_RULES = rules.TypeRules(TYPE_MAP)
+
 def _cpptype(ct):
-    return TYPE_MAP.get(ct, ct)
+    return _TYPE_RULES.map(ct)
 
 
 class ExprVisitor(c_ast.NodeVisitor):
@@ -52,7 +57,24 @@ class ExprVisitor(c_ast.NodeVisitor):
         return n.name
 
     def visit_BinaryOp(self, n):
-        return f'({self.visit(n.left)} {n.op} {self.visit(n.right)})'
+        # Flatten operator chains into a fragment list, joined once per
+        # chain: recursive concatenation is O(n^2) on long arithmetic.
+        parts = []
+        self._binop_parts(n, parts)
+        return ''.join(parts)
+
+    def _binop_parts(self, n, parts):
+        parts.append('(')
+        if isinstance(n.left, c_ast.BinaryOp):
+            self._binop_parts(n.left, parts)
+        else:
+            parts.append(self.visit(n.left))
+        parts.append(f' {n.op} ')
+        if isinstance(n.right, c_ast.BinaryOp):
+            self._binop_parts(n.right, parts)
+        else:
+            parts.append(self.visit(n.right))
+        parts.append(')')
 
     def visit_UnaryOp(self, n):
         e, op = self.visit(n.expr), n.op
@@ -352,51 +374,54 @@ def _extract(decl):
     return (_cpptype(ts), name, is_arr, arr_sz, is_2d, sz2)
 
 
-def _uses_scanf(node):
-    class F(c_ast.NodeVisitor):
-        found = False
-        def visit_FuncCall(self, n):
-            if isinstance(n.name, c_ast.ID) and n.name.name == 'scanf':
-                self.found = True
-            self.generic_visit(n)
-    f = F(); f.visit(node); return f.found
-
-
-def _uses_strings(node):
-    class F(c_ast.NodeVisitor):
-        found = False
-        def visit_Decl(self, n):
-            if isinstance(n.type, c_ast.ArrayDecl):
-                if _gtype(n.type.type) == 'char': self.found = True
-            elif isinstance(n.type, c_ast.PtrDecl):
-                if _gtype(n.type.type) == 'char': self.found = True
-            self.generic_visit(n)
-    f = F(); f.visit(node); return f.found
-
-
-def _uses_file_io(node):
-    class F(c_ast.NodeVisitor):
-        found = False
-        def visit_FuncCall(self, n):
-            if isinstance(n.name, c_ast.ID) and n.name.name in ('fopen','fclose','fread','fwrite','fgets','fputs','fprintf','fscanf'):
-                self.found = True
-            self.generic_visit(n)
-    f = F(); f.visit(node); return f.found
-
-def _uses_algorithm(node):
-    class F(c_ast.NodeVisitor):
-        found = False
-        def visit_FuncCall(self, n):
-            if isinstance(n.name, c_ast.ID) and n.name.name in ('qsort','bsearch','memcpy','memmove','memset','memcmp'):
-                self.found = True
-            self.generic_visit(n)
-    f = F(); f.visit(node); return f.found
+class _FeatureScan(c_ast.NodeVisitor):
+    """Single-pass feature detection over the whole AST.
+
+    Collects every flag the include emitter needs in one traversal,
+    instead of one full AST walk per feature. New detectors go here,
+    not in another standalone walker.
+    """
+
+    FILE_IO_FUNCS = {'fopen','fclose','fread','fwrite','fgets','fputs',
+                     'fprintf','fscanf'}
+    ALGO_FUNCS    = {'qsort','bsearch','memcpy','memmove','memset','memcmp'}
+
+    def __init__(self):
+        self.uses_scanf     = False
+        self.uses_strings   = False
+        self.uses_math      = False
+        self.uses_file_io   = False
+        self.uses_algorithm = False
+
+    def visit_FuncCall(self, n):
+        if isinstance(n.name, c_ast.ID):
+            name = n.name.name
+            if name == 'scanf':             self.uses_scanf = True
+            if name in self.FILE_IO_FUNCS:  self.uses_file_io = True
+            if name in self.ALGO_FUNCS:     self.uses_algorithm = True
+            if name in MATH_FUNCS:          self.uses_math = True
+        self.generic_visit(n)
+
+    def visit_ID(self, n):
+        if n.name in ('M_PI', 'M_E'):
+            self.uses_math = True
+
+    def visit_Decl(self, n):
+        if isinstance(n.type, c_ast.ArrayDecl):
+            if _gtype(n.type.type) == 'char': self.uses_strings = True
+        elif isinstance(n.type, c_ast.PtrDecl):
+            if _gtype(n.type.type) == 'char': self.uses_strings = True
+        self.generic_visit(n)
 
 
 # ---------------------------------------------------------------------------
 class CToCppVisitor(c_ast.NodeVisitor):
 
     def __init__(self):
+        self.reset()
+
+    def reset(self):
+        """Clear per-file state so a warm instance can be reused."""
         self.indent  = 0
         self.output  = []
         self.uses_io = False
@@ -413,11 +438,13 @@ class CToCppVisitor(c_ast.NodeVisitor):
     def _e(self, n): return ExprVisitor().visit(n)
 
     def visit_FileAST(self, node):
+        scan = _FeatureScan()
+        scan.visit(node)
         self.uses_io = True
-        self.uses_string = _uses_strings(node)
-        self.uses_math = any(f in str(node) for f in MATH_FUNCS)
-        self.uses_fstream = _uses_file_io(node)
-        self.uses_algorithm = _uses_algorithm(node)
+        self.uses_string = scan.uses_strings
+        self.uses_math = scan.uses_math
+        self.uses_fstream = scan.uses_file_io
+        self.uses_algorithm = scan.uses_algorithm
 
         # Emit includes
         self.emit('#include <iostream>')
@@ -723,28 +750,93 @@ class CToCppVisitor(c_ast.NodeVisitor):
 # ---------------------------------------------------------------------------
 #  Public API
 # ---------------------------------------------------------------------------
-def translate_string(c_source: str) -> str:
-    parser = pycparser.CParser()
+def _drop_preamble(ast, n_pre):
+    """Drop top-level declarations on the first n_pre source lines: the
+    preamble (symbol index or hoisted fake headers) exists only so the
+    parse succeeds, and must never reach emission."""
+    ast.ext = [d for d in ast.ext
+               if d.coord is None or d.coord.line > n_pre]
+    return ast
+
+
+def _parse_with_symbols(c_source, symbols):
+    """Parse with the project symbol preamble prepended, then drop the
+    preamble's own declarations (identified by source line)."""
+    import ast_cache
+    pre = symbols.preamble()
+    n_pre = pre.count('\n') + 1
+    return _drop_preamble(ast_cache.parse_string(pre + '\n' + c_source),
+                          n_pre)
+
+
+_WARM = threading.local()
+
+
+def warm_visitor():
+    """Per-thread reusable CToCppVisitor (reset between files; thread-
+    local so concurrent translate_string callers never share output
+    state)."""
+    v = getattr(_WARM, 'instance', None)
+    if v is None:
+        v = CToCppVisitor()
+        _WARM.instance = v
+    else:
+        v.reset()
+    return v
+
+
+def translate_string(c_source: str, symbols=None) -> str:
+    import ast_cache
+    try:
+        if symbols is not None and len(symbols):
+            try:
+                ast = _parse_with_symbols(c_source, symbols)
+            except pycparser.plyparser.ParseError:
+                ast = ast_cache.parse_string(c_source)
+        else:
+            ast = ast_cache.parse_string(c_source)
+    except pycparser.plyparser.ParseError as e:
+        raise ValueError(f'C parse error: {e}') from e
+    v = warm_visitor()
+    v.visit(ast)
+    return v.result()
+
+
+def translate_preprocessed(c_text: str, n_pre: int) -> str:
+    """translate_string for bundled-preprocessor output: the first n_pre
+    lines are hoisted fake headers whose declarations must never be
+    emitted. Pipe mode preprocesses in memory and lands here."""
+    import ast_cache
     try:
-        ast = parser.parse(c_source, filename='<string>')
+        ast = _drop_preamble(ast_cache.parse_string(c_text), n_pre)
     except pycparser.plyparser.ParseError as e:
         raise ValueError(f'C parse error: {e}') from e
-    v = CToCppVisitor()
+    v = warm_visitor()
     v.visit(ast)
     return v.result()
 
 
-def translate_file(c_path: str) -> str:
+def translate_file(c_path: str, symbols=None) -> str:
     import re, os
+    # In-process preprocessing with bundled fake headers: no subprocess.
+    # The hoisted header preamble must be dropped before emission or the
+    # fake declarations would be re-emitted as (broken) C++.
+    try:
+        import preprocess, ast_cache
+        text, n_pre = preprocess.preprocess_file(c_path)
+        ast = _drop_preamble(ast_cache.parse_string(text), n_pre)
+        v = warm_visitor(); v.visit(ast); return v.result()
+    except Exception:
+        pass
     fake = os.path.join(os.path.dirname(pycparser.__file__), 'utils', 'fake_libc_include')
     try:
-        ast = pycparser.parse_file(c_path, use_cpp=True,
-                                   cpp_path='gcc', cpp_args=['-E', f'-I{fake}'])
-        v = CToCppVisitor(); v.visit(ast); return v.result()
+        import ast_cache
+        ast = ast_cache.parse_file(c_path, cpp_args=['-E', f'-I{fake}'])
+        v = warm_visitor(); v.visit(ast); return v.result()
     except Exception:
         pass
     with open(c_path, encoding='utf-8') as f:
         src = f.read()
     src = re.sub(r'//.*?$|/\*.*?\*/', '', src, flags=re.M | re.S)
     src = '\n'.join(l for l in src.splitlines() if not l.strip().startswith('#'))
-    return translate_string(src)
+    return translate_string(src, symbols=symbols)
@@ -16,8 +16,11 @@
 #    malloc/free -> new/comment, #define constants, unsigned types
 # =============================================================================
 
+import threading
+
 import pycparser
 from pycparser import c_ast
+import rules
 
 TYPE_MAP = {
     'int':'int','float':'float','double':'double','char':'char',
@@ -80,11 +83,12 @@ STRING_FUNC_2 = {
     'atan2':   lambda a,b: f'Math.atan2({a}, {b})',
 }
 
-def _jtype(ct): return TYPE_MAP.get(ct, ct)
-def _lib(name, args):
-    if name in STRING_FUNC_1 and args: return STRING_FUNC_1[name](args[0])
-    if name in STRING_FUNC_2 and len(args)>=2: return STRING_FUNC_2[name](args[0],args[1])
-    return None
+# Compiled once at import; memoizes derived (pointer/array) spellings too.
+_TYPE_RULES = rules.TypeRules(TYPE_MAP, derive=True, char_pointer='String')
+_CALL_RULES = rules.CallRules(unary=STRING_FUNC_1, binary=STRING_FUNC_2)
+
+def _jtype(ct): return _TYPE_RULES.map(ct)
+def _lib(name, args): return _CALL_RULES.apply(name, args)
 
 
 # ---------------------------------------------------------------------------
@@ -110,7 +114,27 @@ class ExprVisitor(c_ast.NodeVisitor):
         return n.name
 
     def visit_BinaryOp(self, n):
-        return f'({self.visit(n.left)} {n.op} {self.visit(n.right)})'
+        # Nested operator chains are flattened into one fragment list and
+        # joined once here, at the chain boundary. Recursive f-string
+        # concatenation copied the whole accumulated string per level,
+        # which is O(n^2) on the 100+ term arithmetic chains in our
+        # generated inputs.
+        parts = []
+        self._binop_parts(n, parts)
+        return ''.join(parts)
+
+    def _binop_parts(self, n, parts):
+        parts.append('(')
+        if isinstance(n.left, c_ast.BinaryOp):
+            self._binop_parts(n.left, parts)
+        else:
+            parts.append(self.visit(n.left))
+        parts.append(f' {n.op} ')
+        if isinstance(n.right, c_ast.BinaryOp):
+            self._binop_parts(n.right, parts)
+        else:
+            parts.append(self.visit(n.right))
+        parts.append(')')
 
     def visit_UnaryOp(self, n):
         e, op = self.visit(n.expr), n.op
@@ -285,6 +309,10 @@ def _to_bool_cond(expr_str: str) -> str:
 class CToJavaVisitor(c_ast.NodeVisitor):
 
     def __init__(self):
+        self.reset()
+
+    def reset(self):
+        """Clear per-file state so a warm instance can be reused."""
         self.indent  = 0
         self.output  = []
         self.scanner = False
@@ -298,6 +326,12 @@ class CToJavaVisitor(c_ast.NodeVisitor):
 
     # ── Top-level ─────────────────────────────────────────────────────────────
     def visit_FileAST(self, node):
+        self._begin_file(node)
+        for item in node.ext:
+            self._top_item(item)
+        self._end_file()
+
+    def _begin_file(self, node):
         self.scanner = _uses_scanf(node)
         needs_math  = any(f in str(node) for f in ('sqrt','pow','sin','cos','Math','fabs','ceil','floor','log','exp'))
 
@@ -306,45 +340,46 @@ class CToJavaVisitor(c_ast.NodeVisitor):
         self.emit('public class Main {'); self.blank()
         self.indent = 1
 
-        for item in node.ext:
-            if isinstance(item, c_ast.FuncDef):
-                self.visit_FuncDef(item); self.blank()
-            elif isinstance(item, c_ast.Decl):
-                if isinstance(item.type, c_ast.Enum):
-                    self._enum_decl(item)
-                elif isinstance(item.type, c_ast.Struct):
-                    self._struct_decl(item)
-                elif isinstance(item.type, c_ast.FuncDecl):
-                    pass  # skip forward declarations
-                else:
-                    jt_, name, is_arr, sz, is_2d, sz2 = _extract(item)
-                    is_const = _is_const(item)
-                    prefix = 'static final' if is_const else 'static'
-                    if is_2d:
-                        if item.init:
-                            self.emit(f'{prefix} {jt_}[][] {name} = {self._e(item.init)};')
-                        elif sz and sz2:
-                            self.emit(f'{prefix} {jt_}[][] {name} = new {jt_}[{sz}][{sz2}];')
-                        else:
-                            self.emit(f'{prefix} {jt_}[][] {name};')
-                    elif is_arr:
-                        if item.init:
-                            self.emit(f'{prefix} {jt_}[] {name} = {self._e(item.init)};')
-                        elif sz:
-                            self.emit(f'{prefix} {jt_}[] {name} = new {jt_}[{sz}];')
-                        else:
-                            self.emit(f'{prefix} {jt_}[] {name};')
-                    else:
-                        if item.init:
-                            self.emit(f'{prefix} {jt_} {name} = {self._e(item.init)};')
-                        else:
-                            self.emit(f'{prefix} {jt_} {name};')
-            elif isinstance(item, c_ast.Typedef):
-                pass  # skip typedefs for now
-
+    def _end_file(self):
         self.indent = 0
         self.emit('}')
 
+    def _top_item(self, item):
+        if isinstance(item, c_ast.FuncDef):
+            self.visit_FuncDef(item); self.blank()
+        elif isinstance(item, c_ast.Decl):
+            if isinstance(item.type, c_ast.Enum):
+                self._enum_decl(item)
+            elif isinstance(item.type, c_ast.Struct):
+                self._struct_decl(item)
+            elif isinstance(item.type, c_ast.FuncDecl):
+                pass  # skip forward declarations
+            else:
+                jt_, name, is_arr, sz, is_2d, sz2 = _extract(item)
+                is_const = _is_const(item)
+                prefix = 'static final' if is_const else 'static'
+                if is_2d:
+                    if item.init:
+                        self.emit(f'{prefix} {jt_}[][] {name} = {self._e(item.init)};')
+                    elif sz and sz2:
+                        self.emit(f'{prefix} {jt_}[][] {name} = new {jt_}[{sz}][{sz2}];')
+                    else:
+                        self.emit(f'{prefix} {jt_}[][] {name};')
+                elif is_arr:
+                    if item.init:
+                        self.emit(f'{prefix} {jt_}[] {name} = {self._e(item.init)};')
+                    elif sz:
+                        self.emit(f'{prefix} {jt_}[] {name} = new {jt_}[{sz}];')
+                    else:
+                        self.emit(f'{prefix} {jt_}[] {name};')
+                else:
+                    if item.init:
+                        self.emit(f'{prefix} {jt_} {name} = {self._e(item.init)};')
+                    else:
+                        self.emit(f'{prefix} {jt_} {name};')
+        elif isinstance(item, c_ast.Typedef):
+            pass  # skip typedefs for now
+
     # ── Enum ──────────────────────────────────────────────────────────────────
     def _enum_decl(self, item):
         enum = item.type
@@ -651,30 +686,169 @@ class CToJavaVisitor(c_ast.NodeVisitor):
 # ---------------------------------------------------------------------------
 #  Public API
 # ---------------------------------------------------------------------------
-def translate_string(c_source: str) -> str:
-    parser  = pycparser.CParser()
+_WARM = threading.local()
+
+
+def warm_visitor():
+    """Per-thread reusable CToJavaVisitor.
+
+    Batch workers translate thousands of files; keeping one instance and
+    reset()-ing it avoids per-file allocation without sharing any state
+    between files. Thread-local rather than module-global because the
+    test and accuracy harnesses call translate_string()/translate_file()
+    from thread pools, and one shared visitor would let a reset() clear
+    another thread's in-progress output.
+    """
+    v = getattr(_WARM, 'instance', None)
+    if v is None:
+        v = CToJavaVisitor()
+        _WARM.instance = v
+    else:
+        v.reset()
+    return v
+
+
+def _drop_preamble(ast, n_pre):
+    """Drop top-level declarations on the first n_pre source lines: the
+    preamble (symbol index or hoisted fake headers) exists only so the
+    parse succeeds, and must never reach emission."""
+    ast.ext = [d for d in ast.ext
+               if d.coord is None or d.coord.line > n_pre]
+    return ast
+
+
+def _parse_with_symbols(c_source, symbols):
+    """Parse with the project symbol preamble prepended, then drop the
+    preamble's own declarations (identified by source line) so only the
+    file's code is emitted."""
+    import ast_cache
+    pre = symbols.preamble()
+    n_pre = pre.count('\n') + 1
+    return _drop_preamble(ast_cache.parse_string(pre + '\n' + c_source),
+                          n_pre)
+
+
+def translate_string(c_source: str, symbols=None) -> str:
+    import ast_cache
     try:
-        ast = parser.parse(c_source, filename='<string>')
+        if symbols is not None and len(symbols):
+            try:
+                ast = _parse_with_symbols(c_source, symbols)
+            except pycparser.plyparser.ParseError:
+                # A malformed header harvest must never break a file that
+                # parses on its own.
+                ast = ast_cache.parse_string(c_source)
+        else:
+            ast = ast_cache.parse_string(c_source)
+    except pycparser.plyparser.ParseError as e:
+        raise ValueError(f'C parse error: {e}') from e
+    v = warm_visitor()
+    v.visit(ast)
+    return v.result()
+
+
+def translate_preprocessed(c_text: str, n_pre: int) -> str:
+    """translate_string for bundled-preprocessor output: the first n_pre
+    lines are hoisted fake headers whose declarations must never be
+    emitted. Pipe mode preprocesses in memory and lands here."""
+    import ast_cache
+    try:
+        ast = _drop_preamble(ast_cache.parse_string(c_text), n_pre)
     except pycparser.plyparser.ParseError as e:
         raise ValueError(f'C parse error: {e}') from e
-    v = CToJavaVisitor()
+    v = warm_visitor()
     v.visit(ast)
     return v.result()
 
 
-def translate_file(c_path: str) -> str:
-    """Parse a C file. Tries pycparser fake_libc first, strips includes on failure."""
+def _file_ast(c_path: str, symbols=None):
+    """Parse a C file to a c_ast. Tries the bundled in-process
+    preprocessor first, then pycparser fake_libc via gcc -E, then strips
+    includes."""
     import re, os
-    # Try with fake libc headers first
+    # In-process preprocessing: no subprocess, cached on disk. The fake
+    # headers come back as a hoisted preamble whose declarations must be
+    # dropped, or stdio scaffolding would leak into the Java output.
+    try:
+        import preprocess, ast_cache
+        text, n_pre = preprocess.preprocess_file(c_path)
+        return _drop_preamble(ast_cache.parse_string(text), n_pre)
+    except Exception:
+        pass
+    # gcc -E with pycparser's fake libc headers
     fake = os.path.join(os.path.dirname(pycparser.__file__), 'utils', 'fake_libc_include')
     try:
-        ast = pycparser.parse_file(c_path, use_cpp=True,
-                                   cpp_path='gcc', cpp_args=['-E', f'-I{fake}'])
-        v = CToJavaVisitor(); v.visit(ast); return v.result()
+        import ast_cache
+        return ast_cache.parse_file(c_path, cpp_args=['-E', f'-I{fake}'])
     except Exception:
         pass
-    # Fallback: strip includes and comments, parse string
+    # Fallback: strip includes and comments, parse string (with the batch
+    # symbol index prepended in project mode, so local-header types resolve)
+    import ast_cache
     with open(c_path, encoding='utf-8') as f: src = f.read()
     src = re.sub(r'//.*?$|/\*.*?\*/', '', src, flags=re.M|re.S)
     src = '\n'.join(l for l in src.splitlines() if not l.strip().startswith('#'))
-    return translate_string(src)
+    try:
+        if symbols is not None and len(symbols):
+            try:
+                return _parse_with_symbols(src, symbols)
+            except pycparser.plyparser.ParseError:
+                return ast_cache.parse_string(src)
+        return ast_cache.parse_string(src)
+    except pycparser.plyparser.ParseError as e:
+        raise ValueError(f'C parse error: {e}') from e
+
+
+def translate_file(c_path: str, symbols=None) -> str:
+    ast = _file_ast(c_path, symbols=symbols)
+    v = warm_visitor(); v.visit(ast); return v.result()
+
+
+def _emit_section(args):
+    """Worker: emit one contiguous slice of top-level declarations."""
+    items, scanner = args
+    v = warm_visitor()
+    v.scanner = scanner
+    v.indent = 1
+    for item in items:
+        v._top_item(item)
+    return v.output
+
+
+def _emit_parallel(ast, jobs):
+    """Partition top-level declarations across worker processes and
+    stitch the emitted sections back in order. Each declaration emits
+    independently (visit_FuncDef resets its own per-function state), so
+    the output is byte-identical to the serial walk."""
+    import concurrent.futures
+    v = warm_visitor()
+    v._begin_file(ast)
+    per_chunk = max(1, (len(ast.ext) + jobs - 1) // jobs)
+    chunks = [(ast.ext[i:i + per_chunk], v.scanner)
+              for i in range(0, len(ast.ext), per_chunk)]
+    if len(chunks) > 1:
+        with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as pool:
+            for section in pool.map(_emit_section, chunks):
+                v.output.extend(section)
+    else:
+        for item in ast.ext:
+            v._top_item(item)
+    v._end_file()
+    return v.result()
+
+
+def translate_file_parallel(c_path: str, jobs: int, symbols=None) -> str:
+    """translate_file for single huge files: top-level declarations fan
+    out across `jobs` processes, which is the only lever left when one
+    file dominates and file-level parallelism can't help."""
+    return _emit_parallel(_file_ast(c_path, symbols=symbols), jobs)
+
+
+def translate_string_parallel(c_source: str, jobs: int) -> str:
+    """translate_string with partitioned emission; same output."""
+    import ast_cache
+    try:
+        ast = ast_cache.parse_string(c_source)
+    except pycparser.plyparser.ParseError as e:
+        raise ValueError(f'C parse error: {e}') from e
+    return _emit_parallel(ast, jobs)
@@ -16,6 +16,7 @@ resolved type, so we can distinguish:
 """
 
 import sys, os
+import rules
 import clang.cindex as ci
 from clang.cindex import CursorKind as CK, TypeKind as TK
 
@@ -46,31 +47,15 @@ MACRO_CONSTS = {
 }
 
 
-def _map_type(clang_type_spelling: str) -> str:
-    """Map a Clang type spelling to a Java type."""
-    s = clang_type_spelling.replace('const ', '').replace('restrict ', '').strip()
-
-    # pointer types
-    if s == 'char *' or s == 'const char *':
-        return 'String'
-    if s.endswith(' *'):
-        base = s[:-2].strip()
-        jt = C_TO_JAVA_TYPE.get(base, base)
-        return f'{jt}[]'
-
-    # 2D arrays like int[2][2]
-    if s.count('[') >= 2:
-        base = s[:s.index('[')].strip()
-        jt = C_TO_JAVA_TYPE.get(base, base)
-        return f'{jt}[][]'
+# Compiled rule table: the const/pointer/array spelling surgery runs at
+# most once per distinct spelling instead of once per cursor.
+_TYPE_RULES = rules.TypeRules(C_TO_JAVA_TYPE, derive=True,
+                              char_pointer='String')
 
-    # sized arrays like char[100]
-    if '[' in s:
-        base = s[:s.index('[')].strip()
-        jt = C_TO_JAVA_TYPE.get(base, base)
-        return f'{jt}[]'
 
-    return C_TO_JAVA_TYPE.get(s, s)
+def _map_type(clang_type_spelling: str) -> str:
+    """Map a Clang type spelling to a Java type (memoized)."""
+    return _TYPE_RULES.map(clang_type_spelling)
 
 
 def _map_type_for_param(cursor) -> str:
@@ -90,29 +75,65 @@ def _map_type_for_param(cursor) -> str:
     return _map_type(cursor.type.spelling)
 
 
+# ── per-translation-unit caches ────────────────────────────────────────────
+#
+# Token text depends only on a cursor's source extent, and "is this variable
+# ever indexed" depends only on the enclosing function, so both are cached
+# per translation unit keyed by extent offsets. Without this, every
+# char-pointer parameter re-walks its whole function body and every token
+# query re-tokenizes, which turns translation quadratic on big functions.
+
+_token_cache = {}        # (file, start offset, end offset) -> token string
+_subscript_cache = {}    # function extent key -> set of subscripted names
+
+
+def _reset_caches():
+    """Drop per-TU caches; called at the start of every translation."""
+    _token_cache.clear()
+    _subscript_cache.clear()
+
+
+def _extent_key(cursor):
+    ext = cursor.extent
+    fname = cursor.location.file.name if cursor.location.file else ''
+    return (fname, ext.start.offset, ext.end.offset)
+
+
 def _is_char_ptr_indexed(func_cursor, var_name: str) -> bool:
-    """Walk a function body looking for array subscript access on 'var_name'."""
-    for c in func_cursor.walk_preorder():
-        if c.kind == CK.ARRAY_SUBSCRIPT_EXPR:
-            children = list(c.get_children())
-            if children:
-                base = children[0]
-                # unwrap implicit casts
-                while base.kind == CK.UNEXPOSED_EXPR:
-                    inner = list(base.get_children())
-                    if inner:
-                        base = inner[0]
-                    else:
-                        break
-                if base.kind == CK.DECL_REF_EXPR and base.spelling == var_name:
-                    return True
-    return False
+    """Check whether 'var_name' is ever used with array subscript access
+    inside the function. The function body is walked once; subsequent
+    queries are set lookups."""
+    key = _extent_key(func_cursor)
+    names = _subscript_cache.get(key)
+    if names is None:
+        names = set()
+        for c in func_cursor.walk_preorder():
+            if c.kind == CK.ARRAY_SUBSCRIPT_EXPR:
+                children = list(c.get_children())
+                if children:
+                    base = children[0]
+                    # unwrap implicit casts
+                    while base.kind == CK.UNEXPOSED_EXPR:
+                        inner = list(base.get_children())
+                        if inner:
+                            base = inner[0]
+                        else:
+                            break
+                    if base.kind == CK.DECL_REF_EXPR:
+                        names.add(base.spelling)
+        _subscript_cache[key] = names
+    return var_name in names
 
 
 def _get_tokens_str(cursor) -> str:
-    """Get the raw source tokens for a cursor."""
-    tokens = list(cursor.get_tokens())
-    return ' '.join(t.spelling for t in tokens)
+    """Get the raw source tokens for a cursor (cached per extent)."""
+    key = _extent_key(cursor)
+    cached = _token_cache.get(key)
+    if cached is None:
+        tokens = list(cursor.get_tokens())
+        cached = ' '.join(t.spelling for t in tokens)
+        _token_cache[key] = cached
+    return cached
 
 
 def _get_array_size(cursor) -> str:
@@ -138,6 +159,11 @@ def _default_value(java_type: str) -> str:
 
 class ClangToJava:
     def __init__(self, tu):
+        self.reset(tu)
+
+    def reset(self, tu):
+        """Rebind to a new translation unit and clear per-file state, so
+        a batch can keep one warm instance instead of reconstructing."""
         self.tu = tu
         self.output = []
         self.indent = 0
@@ -151,6 +177,7 @@ class ClangToJava:
         self.output.append('    ' * self.indent + line)
 
     def translate(self) -> str:
+        _reset_caches()
         src_file = self.tu.spelling
 
         # First pass: collect function return types for semantic boolean resolution
@@ -1043,6 +1070,90 @@ def _get_compound_assign_op(cursor) -> str:
     return '+='
 
 
+# ── batch translation ──────────────────────────────────────────────────────
+
+# The common include set for our corpus. Nearly every sample pulls in some
+# subset of these, and for small-function-heavy files parsing them dominates
+# the whole translation.
+COMMON_HEADERS = ('stdio.h', 'stdlib.h', 'string.h', 'math.h')
+
+
+class ClangBatch:
+    """Translates many files with one shared clang Index and a precompiled
+    header for the common libc include set.
+
+    A fresh Index.parse() re-reads stdio.h/stdlib.h/string.h from scratch
+    per file. This keeps a single Index alive for the whole batch and
+    builds a PCH of COMMON_HEADERS once, injected into every parse with
+    -include-pch, so per-file parse cost reflects only user code. If the
+    PCH cannot be built (old libclang, odd sysroot) we silently fall back
+    to plain parses on the shared Index.
+    """
+
+    def __init__(self):
+        self.index = ci.Index.create()
+        self._pch_path = None
+        self._pch_failed = False
+        self._translator = None   # warm ClangToJava, reset per file
+
+    def _ensure_pch(self):
+        if self._pch_path or self._pch_failed:
+            return
+        import tempfile
+        try:
+            fd, hdr = tempfile.mkstemp(suffix='.h',
+                                       dir=tempfile.gettempdir())
+            with os.fdopen(fd, 'w') as f:
+                for h in COMMON_HEADERS:
+                    f.write(f'#include <{h}>\n')
+            pch = hdr + '.pch'
+            tu = self.index.parse(
+                hdr, args=['-std=c11', '-x', 'c-header'],
+                options=ci.TranslationUnit.PARSE_INCOMPLETE)
+            tu.save(pch)
+            os.unlink(hdr)
+            self._pch_path = pch
+        except (ci.TranslationUnitSaveError, ci.TranslationUnitLoadError,
+                OSError):
+            self._pch_failed = True
+
+    def parse(self, filepath: str):
+        """Parse one file, reusing the shared index and PCH when available."""
+        self._ensure_pch()
+        args = ['-std=c11']
+        if self._pch_path:
+            args += ['-include-pch', self._pch_path]
+            try:
+                return self.index.parse(filepath, args=args)
+            except ci.TranslationUnitLoadError:
+                # PCH went stale or mismatched; drop it for the rest of
+                # the batch rather than failing every file.
+                self._pch_failed = True
+                self._pch_path = None
+        return self.index.parse(filepath, args=['-std=c11'])
+
+    def translate_file(self, filepath: str) -> str:
+        tu = self.parse(filepath)
+        if self._translator is None:
+            self._translator = ClangToJava(tu)
+        else:
+            self._translator.reset(tu)
+        return self._translator.translate()
+
+    def translate_files(self, filepaths):
+        """Yield (filepath, java_source) for each input, in order."""
+        for fp in filepaths:
+            yield fp, self.translate_file(fp)
+
+    def close(self):
+        if self._pch_path:
+            try:
+                os.unlink(self._pch_path)
+            except OSError:
+                pass
+            self._pch_path = None
+
+
 # ── entry points ───────────────────────────────────────────────────────────
 
 def translate_file(filepath: str) -> str:
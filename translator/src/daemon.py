@@ -0,0 +1,129 @@
+# =============================================================================
+#  daemon.py  -- persistent translation server
+#
+#  Loads all parsers (javalang, pycparser, tree-sitter) once and then serves
+#  translation jobs until stopped, so callers pay interpreter + parser
+#  startup a single time instead of per invocation.
+#
+#  Protocol: one JSON object per line (NDJSON), both directions.
+#
+#  Request:
+#    {"direction": "java_to_c", "source": "..."}     translate a string
+#    {"direction": "c_to_java", "path": "foo.c"}     translate a file on disk
+#    {"cmd": "ping"}                                 liveness check
+#    {"cmd": "shutdown"}                             stop the server
+#
+#  Response:
+#    {"ok": true, "output": "..."}
+#    {"ok": false, "error": "..."}
+#
+#  Started via:
+#    uv run python src/main.py --daemon              serve stdin/stdout
+#    uv run python src/main.py --daemon --port 7632  serve localhost TCP
+# =============================================================================
+
+import sys, os, json, socket
+
+sys.path.insert(0, os.path.dirname(__file__))
+
+import java_to_c
+import java_to_cpp
+import c_to_java
+import c_to_cpp
+import cpp_to_c
+import cpp_to_java
+
+DIRECTIONS = {
+    'java_to_c':   java_to_c,
+    'java_to_cpp': java_to_cpp,
+    'c_to_java':   c_to_java,
+    'c_to_cpp':    c_to_cpp,
+    'cpp_to_c':    cpp_to_c,
+    'cpp_to_java': cpp_to_java,
+}
+
+DEFAULT_PORT = 7632
+
+
+def handle_request(req: dict) -> dict:
+    """Translate one request dict into one response dict."""
+    cmd = req.get('cmd')
+    if cmd == 'ping':
+        return {'ok': True, 'output': 'pong'}
+    if cmd == 'shutdown':
+        return {'ok': True, 'output': 'bye', 'shutdown': True}
+
+    direction = req.get('direction')
+    mod = DIRECTIONS.get(direction)
+    if mod is None:
+        return {'ok': False,
+                'error': f'Unknown direction: {direction!r}. '
+                         f'Expected one of: {", ".join(sorted(DIRECTIONS))}'}
+
+    try:
+        if 'path' in req:
+            output = mod.translate_file(req['path'])
+        elif 'source' in req:
+            output = mod.translate_string(req['source'])
+        else:
+            return {'ok': False, 'error': 'Request needs "source" or "path".'}
+        return {'ok': True, 'output': output}
+    except Exception as e:
+        return {'ok': False, 'error': str(e)}
+
+
+def serve_stdio():
+    """Serve NDJSON requests on stdin, responses on stdout."""
+    print('[daemon] Ready (stdin protocol). One JSON request per line.',
+          file=sys.stderr)
+    for line in sys.stdin:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            req = json.loads(line)
+        except ValueError as e:
+            resp = {'ok': False, 'error': f'Bad JSON: {e}'}
+        else:
+            resp = handle_request(req)
+        print(json.dumps(resp), flush=True)
+        if resp.get('shutdown'):
+            break
+
+
+def serve_socket(port: int = DEFAULT_PORT):
+    """Serve NDJSON requests over a localhost TCP socket."""
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(('127.0.0.1', port))
+    srv.listen(4)
+    print(f'[daemon] Listening on 127.0.0.1:{port}', file=sys.stderr)
+
+    shutdown = False
+    while not shutdown:
+        conn, addr = srv.accept()
+        with conn, conn.makefile('r', encoding='utf-8') as rf:
+            for line in rf:
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    req = json.loads(line)
+                except ValueError as e:
+                    resp = {'ok': False, 'error': f'Bad JSON: {e}'}
+                else:
+                    resp = handle_request(req)
+                conn.sendall((json.dumps(resp) + '\n').encode('utf-8'))
+                if resp.get('shutdown'):
+                    shutdown = True
+                    break
+    srv.close()
+
+
+if __name__ == '__main__':
+    if '--port' in sys.argv:
+        idx = sys.argv.index('--port')
+        port = int(sys.argv[idx + 1]) if idx + 1 < len(sys.argv) else DEFAULT_PORT
+        serve_socket(port)
+    else:
+        serve_stdio()
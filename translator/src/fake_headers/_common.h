@@ -0,0 +1,5 @@
+/* Shared primitive typedefs for the bundled fake headers. */
+typedef unsigned long size_t;
+typedef long ssize_t;
+typedef long ptrdiff_t;
+#define NULL ((void*)0)
@@ -0,0 +1 @@
+void assert(int expression);
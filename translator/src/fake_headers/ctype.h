@@ -0,0 +1,9 @@
+int isalpha(int c);
+int isdigit(int c);
+int isalnum(int c);
+int isspace(int c);
+int isupper(int c);
+int islower(int c);
+int ispunct(int c);
+int toupper(int c);
+int tolower(int c);
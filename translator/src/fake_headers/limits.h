@@ -0,0 +1,10 @@
+#define CHAR_BIT 8
+#define CHAR_MAX 127
+#define CHAR_MIN (-128)
+#define INT_MAX 2147483647
+#define INT_MIN (-2147483648)
+#define LONG_MAX 9223372036854775807L
+#define LONG_MIN (-9223372036854775807L)
+#define SHRT_MAX 32767
+#define SHRT_MIN (-32768)
+#define UINT_MAX 4294967295U
@@ -0,0 +1,14 @@
+double sqrt(double x);
+double pow(double x, double y);
+double fabs(double x);
+double floor(double x);
+double ceil(double x);
+double fmod(double x, double y);
+double sin(double x);
+double cos(double x);
+double tan(double x);
+double log(double x);
+double log10(double x);
+double exp(double x);
+double round(double x);
+#define M_PI 3.14159265358979323846
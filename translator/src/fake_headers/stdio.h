@@ -0,0 +1,26 @@
+#include "_common.h"
+typedef struct _IO_FILE FILE;
+extern FILE *stdin;
+extern FILE *stdout;
+extern FILE *stderr;
+int printf(const char *format, ...);
+int fprintf(FILE *stream, const char *format, ...);
+int sprintf(char *str, const char *format, ...);
+int snprintf(char *str, size_t size, const char *format, ...);
+int scanf(const char *format, ...);
+int fscanf(FILE *stream, const char *format, ...);
+int sscanf(const char *str, const char *format, ...);
+int puts(const char *s);
+int putchar(int c);
+int getchar(void);
+char *fgets(char *s, int size, FILE *stream);
+int fputs(const char *s, FILE *stream);
+int fgetc(FILE *stream);
+int fputc(int c, FILE *stream);
+FILE *fopen(const char *path, const char *mode);
+int fclose(FILE *stream);
+size_t fread(void *ptr, size_t size, size_t nmemb, FILE *stream);
+size_t fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream);
+int feof(FILE *stream);
+int fflush(FILE *stream);
+#define EOF (-1)
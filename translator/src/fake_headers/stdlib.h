@@ -0,0 +1,18 @@
+#include "_common.h"
+void *malloc(size_t size);
+void *calloc(size_t nmemb, size_t size);
+void *realloc(void *ptr, size_t size);
+void free(void *ptr);
+int atoi(const char *nptr);
+double atof(const char *nptr);
+long atol(const char *nptr);
+int rand(void);
+void srand(unsigned int seed);
+void exit(int status);
+int abs(int j);
+long labs(long j);
+void qsort(void *base, size_t nmemb, size_t size,
+           int (*compar)(const void *, const void *));
+#define RAND_MAX 2147483647
+#define EXIT_SUCCESS 0
+#define EXIT_FAILURE 1
@@ -0,0 +1,18 @@
+#include "_common.h"
+typedef long time_t;
+typedef long clock_t;
+struct tm {
+    int tm_sec;
+    int tm_min;
+    int tm_hour;
+    int tm_mday;
+    int tm_mon;
+    int tm_year;
+    int tm_wday;
+    int tm_yday;
+    int tm_isdst;
+};
+time_t time(time_t *tloc);
+clock_t clock(void);
+struct tm *localtime(const time_t *timep);
+#define CLOCKS_PER_SEC 1000000
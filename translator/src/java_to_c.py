@@ -13,6 +13,8 @@
 #    null->NULL, final->const, enum, try/catch (comment), println/printf
 # =============================================================================
 
+import threading
+
 from pycparser import c_ast, c_generator
 import javalang.tree as jt
 
@@ -62,6 +64,10 @@ def _is_vd(n):
 class JavaToCVisitor:
 
     def __init__(self):
+        self.reset()
+
+    def reset(self):
+        """Clear per-file state so a warm instance can be reused."""
         self.has_printf    = False
         self.has_string_h  = False
         self.has_math_h    = False
@@ -69,6 +75,11 @@ class JavaToCVisitor:
         self.has_arraylist = False
         self.has_scanner   = False
         self.fwd_decls     = []
+        # The pycparser nodes built per method, kept for the fused
+        # Java -> C++ direction (java_to_cpp.py) so it can skip the
+        # intermediate C re-parse.
+        self.c_fwd_decl_nodes = []
+        self.c_func_nodes     = []
         self._fi_ctr       = 0
         self._al_ctr       = 0
         # Array tracking for .length handling
@@ -171,6 +182,8 @@ class JavaToCVisitor:
         fdef = c_ast.FuncDef(decl=decl, param_decls=None, body=_compound(body))
         if not is_main:
             self.fwd_decls.append(GEN.visit(decl) + ';')
+            self.c_fwd_decl_nodes.append(decl)
+        self.c_func_nodes.append(fdef)
         return GEN.visit(fdef)
     
     # ── Scan for array.length usage ───────────────────────────────────────────
@@ -785,13 +798,29 @@ void arraylist_free(ArrayList *a){free(a->data);a->data=NULL;a->size=0;}
 # ---------------------------------------------------------------------------
 #  Public API
 # ---------------------------------------------------------------------------
+_WARM = threading.local()
+
+
+def warm_visitor():
+    """Per-thread reusable JavaToCVisitor (reset between files; the
+    threaded test harnesses call translate_string concurrently, so the
+    warm instance must not be shared across threads)."""
+    v = getattr(_WARM, 'instance', None)
+    if v is None:
+        v = JavaToCVisitor()
+        _WARM.instance = v
+    else:
+        v.reset()
+    return v
+
+
 def translate_string(java_source: str) -> str:
     import javalang
     try:
         tree = javalang.parse.parse(java_source)
     except javalang.parser.JavaSyntaxError as e:
         raise ValueError(f'Java parse error: {e}') from e
-    v = JavaToCVisitor()
+    v = warm_visitor()
     return v.translate(tree)
 
 
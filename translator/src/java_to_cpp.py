@@ -0,0 +1,69 @@
+# =============================================================================
+#  java_to_cpp.py  -- fused Java -> C++ translator (single parse)
+#
+#  Uses: javalang (Java AST)  +  the pycparser C AST that JavaToCVisitor
+#  already builds, fed straight into CToCppVisitor.
+#
+#  The two-step route (java_to_c emit C text, c_to_cpp re-parse it with
+#  pycparser) pays a second full parser pass plus intermediate file I/O.
+#  Here the C AST nodes built during the Java walk are wrapped in a FileAST
+#  and handed directly to the C++ emitter, so Java source is parsed exactly
+#  once. Pieces that java_to_c produces as text rather than AST (enums,
+#  static fields, HashMap/ArrayList helpers) are spliced in after the
+#  include block; they are all C++-compatible as emitted.
+# =============================================================================
+
+import sys, os
+
+sys.path.insert(0, os.path.dirname(__file__))
+
+from pycparser import c_ast
+
+import java_to_c
+import c_to_cpp
+from java_to_c import jt
+
+
+def translate_string(java_source: str) -> str:
+    import javalang
+    try:
+        tree = javalang.parse.parse(java_source)
+    except javalang.parser.JavaSyntaxError as e:
+        raise ValueError(f'Java parse error: {e}') from e
+
+    # Walk the Java AST once; the visitor builds pycparser nodes per method
+    # as a side effect of emitting C.
+    v = java_to_c.warm_visitor()
+    v.translate(tree)
+
+    file_ast = c_ast.FileAST(ext=list(v.c_fwd_decl_nodes) + list(v.c_func_nodes))
+    emitter = c_to_cpp.warm_visitor()
+    emitter.visit(file_ast)
+    lines = emitter.output
+
+    # Residual text pieces: enums, static fields, container helpers.
+    extra = []
+    if v.has_hashmap:
+        extra.append(v._hashmap_code())
+    if v.has_arraylist:
+        extra.append(v._arraylist_code())
+    cls = tree.types[0]
+    for m in cls.body:
+        if isinstance(m, jt.EnumDeclaration):
+            extra.append(v._enum(m))
+        elif isinstance(m, jt.FieldDeclaration):
+            extra.extend(v._field_decl(m))
+    if extra:
+        extra.append('')
+        try:
+            pos = lines.index('using namespace std;') + 2
+        except ValueError:
+            pos = 0
+        lines[pos:pos] = extra
+
+    return '\n'.join(lines)
+
+
+def translate_file(java_path: str) -> str:
+    with open(java_path, encoding='utf-8') as f:
+        return translate_string(f.read())
@@ -10,6 +10,10 @@
 #    uv run python src/main.py input.c   --to cpp  -> C   -> C++
 #    uv run python src/main.py input.cpp           -> C++ -> C
 #
+#  Pipe mode (stdin -> stdout, zero intermediate files):
+#    cat input.c | uv run python src/main.py - --lang c        > out.java
+#    cat input.java | uv run python src/main.py - --lang java --to cpp
+#
 #  Folder batch mode:
 #    uv run python src/main.py samples/            -> translate all files
 #    uv run python src/main.py samples/ --to cpp   -> all C files -> C++
@@ -18,19 +22,43 @@
 #
 #  Flags:
 #    --verify    compile output with gcc/g++/javac
+#    --verify-fast  syntax-only verification (gcc/g++ -fsyntax-only)
 #    --ast       show AST before translation
-#    --to cpp    force C -> C++ direction
+#    --to cpp    translate toward C++ (.c -> .cpp, .java -> .cpp fused)
+#    --to java   translate toward Java (.cpp -> .java fused)
 #    --output DIR  output directory (batch mode)
+#    --output-archive FILE  stream batch outputs into one .tar/.zip
+#    --lang L    source language for '-' (stdin) mode: c, java or cpp
+#    --jobs N    translate N files in parallel (batch mode); for a single
+#                large .c file, fan its declarations across N processes
+#    --incremental  skip files whose source is unchanged (batch mode)
+#    --verify-batch compile all outputs in one compiler run per language
+#    --verify-session keep one WSL shell alive for all per-file compiles
+#    --slowest N show the N slowest files with per-stage timings
+#    --watch keep re-translating a folder as its files change
+#    --report FILE stream per-file NDJSON results as the batch runs
+#    --project   build a shared symbol index from headers (batch mode)
+#    --shard i/N translate only the i-th of N deterministic file slices
+#    --cache-dir DIR  shared content-addressed translation store
+#                     (default: $C2JAVA_SHARED_CACHE)
+#    --merge-shards OUT IN...  combine shard reports + caches into OUT
+#    --profile print per-node-type visit counts and times at exit
+#    --daemon    run as a persistent translation server (see daemon.py)
 #    --demo      run built-in demos
 # =============================================================================
 
-import sys, os, pathlib, tempfile, time
+import sys, os, pathlib, tempfile, time, fnmatch
+import concurrent.futures
+import hashlib, json
+
+# Bump whenever translator output changes, so --incremental re-translates
+# everything instead of serving stale cached results.
+TRANSLATOR_VERSION = '0.1.0'
 sys.path.insert(0, os.path.dirname(__file__))
 
-import java_to_c
-import c_to_java
-import c_to_cpp
-import cpp_to_c
+# The translator backends are imported lazily inside the run_* functions:
+# each one drags in a heavyweight parser (javalang, pycparser, tree-sitter),
+# and a single-direction invocation should only pay for the parser it uses.
 from verify import compile_c_wsl, compile_java_wsl, compile_cpp_wsl
 
 
@@ -109,6 +137,7 @@ int main() {
 
 def run_java_to_c(source: str, out_name: str,
                   show_ast: bool, verify: bool, quiet: bool = False):
+    import java_to_c
     if not quiet:
         print(f'\n  Mode     : Java -> C')
         print(f'  Parser   : javalang (Java AST)')
@@ -145,7 +174,7 @@ def run_java_to_c(source: str, out_name: str,
     if verify:
         if not quiet:
             print('\n[WSL gcc] Compiling generated C...')
-        ok, msg = compile_c_wsl(c_code)
+        ok, msg = compile_c_wsl(c_code, syntax_only=(verify == 'fast'))
         if not quiet:
             status  = 'PASS' if ok else 'FAIL'
             print(f'  gcc [{status}]: {msg}')
@@ -155,7 +184,8 @@ def run_java_to_c(source: str, out_name: str,
 
 
 def run_c_to_java(path: str, out_name: str, show_ast: bool,
-                  verify: bool = False, quiet: bool = False):
+                  verify: bool = False, quiet: bool = False, jobs: int = 1):
+    import c_to_java
     if not quiet:
         print(f'\n  Mode     : C -> Java')
         print(f'  Parser   : pycparser (C AST)')
@@ -178,7 +208,12 @@ def run_c_to_java(path: str, out_name: str, show_ast: bool,
             print(f'[AST] {e}')
 
     try:
-        java_code = c_to_java.translate_file(path)
+        if jobs > 1:
+            # Huge single files: fan top-level declarations out across
+            # processes instead of walking them serially.
+            java_code = c_to_java.translate_file_parallel(path, jobs)
+        else:
+            java_code = c_to_java.translate_file(path)
     except (ValueError, Exception) as e:
         if quiet:
             return None, str(e)
@@ -197,7 +232,7 @@ def run_c_to_java(path: str, out_name: str, show_ast: bool,
     if verify:
         if not quiet:
             print('\n[WSL javac] Compiling generated Java...')
-        ok, msg = compile_java_wsl(java_code)
+        ok, msg = compile_java_wsl(java_code, syntax_only=(verify == 'fast'))
         if not quiet:
             status  = 'PASS' if ok else 'FAIL'
             print(f'  javac [{status}]: {msg}')
@@ -206,8 +241,57 @@ def run_c_to_java(path: str, out_name: str, show_ast: bool,
     return java_code, 'OK'
 
 
+def run_java_to_cpp(source: str, out_name: str,
+                    show_ast: bool, verify: bool, quiet: bool = False):
+    import java_to_cpp
+    if not quiet:
+        print(f'\n  Mode     : Java -> C++ (fused, single parse)')
+        print(f'  Parser   : javalang (Java AST)')
+        print(f'  Backend  : pycparser C AST -> C++ emitter')
+        print('-' * 48)
+
+    if show_ast:
+        try:
+            import javalang
+            tree = javalang.parse.parse(source)
+            print('\n[javalang AST]')
+            print(tree)
+            print()
+        except Exception as e:
+            print(f'[AST] {e}')
+
+    try:
+        cpp_code = java_to_cpp.translate_string(source)
+    except (ValueError, Exception) as e:
+        if quiet:
+            return None, str(e)
+        print(f'[ERROR] {e}')
+        sys.exit(1)
+
+    if not quiet:
+        print('\n[Generated C++ Code]')
+        print(cpp_code)
+
+    with open(out_name, 'w', encoding='utf-8') as f:
+        f.write(cpp_code)
+    if not quiet:
+        print(f'\n[OK] Saved -> {out_name}')
+
+    if verify:
+        if not quiet:
+            print('\n[WSL g++] Compiling generated C++...')
+        ok, msg = compile_cpp_wsl(cpp_code, syntax_only=(verify == 'fast'))
+        if not quiet:
+            status  = 'PASS' if ok else 'FAIL'
+            print(f'  g++ [{status}]: {msg}')
+        return cpp_code, ('PASS' if ok else f'FAIL: {msg}')
+
+    return cpp_code, 'OK'
+
+
 def run_c_to_cpp(path: str, out_name: str, show_ast: bool,
                  verify: bool = False, quiet: bool = False):
+    import c_to_cpp
     if not quiet:
         print(f'\n  Mode     : C -> C++')
         print(f'  Parser   : pycparser (C AST)')
@@ -249,7 +333,7 @@ def run_c_to_cpp(path: str, out_name: str, show_ast: bool,
     if verify:
         if not quiet:
             print('\n[WSL g++] Compiling generated C++...')
-        ok, msg = compile_cpp_wsl(cpp_code)
+        ok, msg = compile_cpp_wsl(cpp_code, syntax_only=(verify == 'fast'))
         if not quiet:
             status  = 'PASS' if ok else 'FAIL'
             print(f'  g++ [{status}]: {msg}')
@@ -260,6 +344,7 @@ def run_c_to_cpp(path: str, out_name: str, show_ast: bool,
 
 def run_cpp_to_c(source: str, out_name: str,
                  show_ast: bool, verify: bool = False, quiet: bool = False):
+    import cpp_to_c
     if not quiet:
         print(f'\n  Mode     : C++ -> C')
         print(f'  Parser   : tree-sitter (C++ AST)')
@@ -286,7 +371,7 @@ def run_cpp_to_c(source: str, out_name: str,
     if verify:
         if not quiet:
             print('\n[WSL gcc] Compiling generated C...')
-        ok, msg = compile_c_wsl(c_code)
+        ok, msg = compile_c_wsl(c_code, syntax_only=(verify == 'fast'))
         if not quiet:
             status  = 'PASS' if ok else 'FAIL'
             print(f'  gcc [{status}]: {msg}')
@@ -295,6 +380,44 @@ def run_cpp_to_c(source: str, out_name: str,
     return c_code, 'OK'
 
 
+def run_cpp_to_java(source: str, out_name: str,
+                    show_ast: bool, verify: bool = False, quiet: bool = False):
+    import cpp_to_java
+    if not quiet:
+        print(f'\n  Mode     : C++ -> Java (fused)')
+        print(f'  Parser   : tree-sitter (C++ AST)')
+        print(f'  Backend  : in-memory C -> Java emitter')
+        print('-' * 48)
+
+    try:
+        java_code = cpp_to_java.translate_string(source)
+    except (ValueError, Exception) as e:
+        if quiet:
+            return None, str(e)
+        print(f'[ERROR] {e}')
+        sys.exit(1)
+
+    if not quiet:
+        print('\n[Generated Java Code]')
+        print(java_code)
+
+    with open(out_name, 'w', encoding='utf-8') as f:
+        f.write(java_code)
+    if not quiet:
+        print(f'\n[OK] Saved -> {out_name}')
+
+    if verify:
+        if not quiet:
+            print('\n[WSL javac] Compiling generated Java...')
+        ok, msg = compile_java_wsl(java_code, syntax_only=(verify == 'fast'))
+        if not quiet:
+            status  = 'PASS' if ok else 'FAIL'
+            print(f'  javac [{status}]: {msg}')
+        return java_code, ('PASS' if ok else f'FAIL: {msg}')
+
+    return java_code, 'OK'
+
+
 # ---------------------------------------------------------------------------
 #  Multi-file / folder batch mode
 # ---------------------------------------------------------------------------
@@ -302,28 +425,91 @@ def run_cpp_to_c(source: str, out_name: str,
 # File extensions we scan for
 SOURCE_EXTS = {'.c', '.java', '.cpp', '.h', '.hpp'}
 
-def discover_files(folder: str) -> list:
-    """Recursively discover source files in a folder."""
-    files = []
-    folder = os.path.abspath(folder)
-    for root, dirs, filenames in os.walk(folder):
-        # Skip hidden dirs and __pycache__
-        dirs[:] = [d for d in dirs if not d.startswith('.') and d != '__pycache__']
-        for name in sorted(filenames):
-            ext = pathlib.Path(name).suffix.lower()
-            if ext in SOURCE_EXTS:
-                files.append(os.path.join(root, name))
-    return files
+# Directories never worth descending into, plus user rules from
+# .translatorignore (glob patterns, one per line, '#' for comments).
+# 'translated' keeps discovery out of our own default output dir, which
+# the old walk would happily re-translate.
+DEFAULT_IGNORES = ('translated', 'build', 'dist', 'node_modules',
+                   '__pycache__')
+IGNORE_FILENAME = '.translatorignore'
 
 
-def get_translation_direction(ext: str, to_cpp: bool):
+def _load_ignore_rules(folder: str) -> list:
+    rules = list(DEFAULT_IGNORES)
+    try:
+        with open(os.path.join(folder, IGNORE_FILENAME),
+                  encoding='utf-8') as f:
+            for line in f:
+                line = line.strip()
+                if line and not line.startswith('#'):
+                    rules.append(line.rstrip('/'))
+    except OSError:
+        pass
+    return rules
+
+
+def _ignored(rel_path: str, name: str, rules: list) -> bool:
+    """Match a bare name or a root-relative path against the rules."""
+    rel_path = rel_path.replace(os.sep, '/')
+    return any(fnmatch.fnmatch(name, pat) or fnmatch.fnmatch(rel_path, pat)
+               for pat in rules)
+
+
+def _scan_dir(path: str, root: str, rules: list):
+    """One directory level: returns (source files, subdirs to descend)."""
+    files, subdirs = [], []
+    try:
+        entries = os.scandir(path)
+    except OSError:
+        return files, subdirs
+    with entries:
+        for entry in entries:
+            name = entry.name
+            rel = os.path.relpath(entry.path, root)
+            if entry.is_dir(follow_symlinks=False):
+                if (name.startswith('.') or _ignored(rel, name, rules)):
+                    continue
+                subdirs.append(entry.path)
+            elif entry.is_file(follow_symlinks=False):
+                ext = pathlib.Path(name).suffix.lower()
+                if ext in SOURCE_EXTS and not _ignored(rel, name, rules):
+                    files.append(entry.path)
+    return files, subdirs
+
+
+def discover_files(folder: str, jobs: int = 8) -> list:
+    """Discover source files with a parallel os.scandir walk.
+
+    Directory levels fan out across a thread pool -- enumeration on
+    NFS-hosted trees is latency-bound, so threads overlap the round
+    trips -- and .translatorignore/DEFAULT_IGNORES rules prune output,
+    VCS and build directories before descending. Result order is
+    sorted, so downstream sharding and summaries stay deterministic.
+    """
+    folder = os.path.abspath(folder)
+    rules = _load_ignore_rules(folder)
+    files = []
+    with concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as pool:
+        pending = {pool.submit(_scan_dir, folder, folder, rules)}
+        while pending:
+            done, pending = concurrent.futures.wait(
+                pending, return_when=concurrent.futures.FIRST_COMPLETED)
+            for fut in done:
+                found, subdirs = fut.result()
+                files.extend(found)
+                for d in subdirs:
+                    pending.add(pool.submit(_scan_dir, d, folder, rules))
+    return sorted(files)
+
+
+def get_translation_direction(ext: str, to_cpp: bool, to_java: bool = False):
     """Determine translation direction from file extension."""
     if ext == '.java':
-        return 'java_to_c'
+        return 'java_to_cpp' if to_cpp else 'java_to_c'
     elif ext == '.c':
         return 'c_to_cpp' if to_cpp else 'c_to_java'
     elif ext == '.cpp':
-        return 'cpp_to_c'
+        return 'cpp_to_java' if to_java else 'cpp_to_c'
     elif ext in ('.h', '.hpp'):
         return 'header'  # headers are copied/skipped
     return None
@@ -333,24 +519,407 @@ def get_output_ext(direction: str) -> str:
     """Get the output file extension for a translation direction."""
     return {
         'java_to_c': '.c',
+        'java_to_cpp': '.cpp',
         'c_to_java': '.java',
+        'cpp_to_java': '.java',
         'c_to_cpp':  '.cpp',
         'cpp_to_c':  '.c',
     }.get(direction, '')
 
 
+ARROWS = {'java_to_c': 'Java->C', 'java_to_cpp': 'Java->C++',
+          'c_to_java': 'C->Java', 'c_to_cpp': 'C->C++',
+          'cpp_to_c': 'C++->C', 'cpp_to_java': 'C++->Java'}
+
+# Incremental translation cache (--incremental), one JSON file per output dir
+CACHE_FILENAME = '.translate_cache.json'
+
+
+def _shard_of(rel_path: str, n: int) -> int:
+    """Deterministic 1-based shard for a file, stable across runs and
+    machines (sha256, not the salted builtin hash), so each machine keeps
+    seeing the same slice and its incremental cache stays warm."""
+    digest = hashlib.sha256(rel_path.replace(os.sep, '/').encode('utf-8'))
+    return int.from_bytes(digest.digest()[:8], 'big') % n + 1
+
+
+def run_merge_shards(out_report: str, in_reports: list):
+    """Combine per-shard NDJSON reports (and any .translate_cache.json
+    sitting next to each report) into one report and one cache.
+
+    Each fleet machine runs  --shard i/N --report shardI/report.ndjson
+    --output shardI/ ; this merge step produces the fleet-wide result
+    table and a combined incremental cache for seeding new machines."""
+    records = []
+    merged_cache = {}
+    for path in in_reports:
+        try:
+            with open(path, encoding='utf-8') as f:
+                records.extend(json.loads(l) for l in f if l.strip())
+        except (OSError, ValueError) as e:
+            print(f'[ERROR] Cannot read report {path}: {e}')
+            sys.exit(1)
+        cache_path = os.path.join(os.path.dirname(path) or '.',
+                                  CACHE_FILENAME)
+        try:
+            with open(cache_path, encoding='utf-8') as f:
+                merged_cache.update(json.load(f))
+        except (OSError, ValueError):
+            pass  # shard ran without --incremental; nothing to merge
+
+    records.sort(key=lambda r: r.get('file', ''))
+    with open(out_report, 'w', encoding='utf-8') as f:
+        for rec in records:
+            f.write(json.dumps(rec) + '\n')
+    if merged_cache:
+        _save_cache(os.path.dirname(out_report) or '.', merged_cache)
+
+    counts = {}
+    for rec in records:
+        status = rec.get('status', 'ERROR').split(':')[0]
+        counts[status] = counts.get(status, 0) + 1
+    print(f'\n  Merged {len(in_reports)} shard reports '
+          f'-> {out_report} ({len(records)} files)')
+    for status in sorted(counts):
+        print(f'    {status:<10} {counts[status]}')
+    if merged_cache:
+        print(f'  Merged cache: {len(merged_cache)} entries '
+              f'-> {os.path.join(os.path.dirname(out_report) or ".", CACHE_FILENAME)}')
+
+
+def _write_if_changed(path: str, text: str) -> bool:
+    """Write text to path unless the file already has that exact content.
+
+    Skipping identical writes keeps output mtimes stable, so downstream
+    build systems watching the translated tree don't rebuild untouched
+    files. Returns True if the file was written.
+    """
+    data = text.encode('utf-8')
+    try:
+        with open(path, 'rb') as f:
+            if f.read() == data:
+                return False
+    except OSError:
+        pass
+    with open(path, 'wb') as f:
+        f.write(data)
+    return True
+
+
+def _content_key(filepath: str, direction: str) -> str:
+    """Hash of source bytes + direction + translator version.
+
+    Any change to the input file, the requested direction, or the
+    translator itself produces a new key and forces re-translation.
+    """
+    h = hashlib.sha256()
+    with open(filepath, 'rb') as f:
+        h.update(f.read())
+    h.update(direction.encode('utf-8'))
+    h.update(TRANSLATOR_VERSION.encode('utf-8'))
+    return h.hexdigest()
+
+
+def _load_cache(output_dir: str) -> dict:
+    cache_path = os.path.join(output_dir, CACHE_FILENAME)
+    try:
+        with open(cache_path, encoding='utf-8') as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+
+def _save_cache(output_dir: str, cache: dict):
+    cache_path = os.path.join(output_dir, CACHE_FILENAME)
+    try:
+        with open(cache_path, 'w', encoding='utf-8') as f:
+            json.dump(cache, f, indent=2, sort_keys=True)
+    except OSError:
+        pass  # cache is best-effort; never fail the batch over it
+
+
+def _translate_one(task):
+    """Translate a single batch task. Runs in the current process or in a
+    --jobs worker; the four translator backends are independent per file.
+
+    Returns (rel_path, status, direction_arrow, stage_times) where
+    stage_times maps read/translate/write/verify to seconds. The backends
+    fuse parsing and emission, so those show up together under
+    'translate'.
+    """
+    (rel_path, filepath, out_path, direction, verify, show_ast,
+     symbols, shared) = task
+    stages = {}
+    if symbols is not None:
+        from symbol_index import SymbolIndex
+        symbols = SymbolIndex.from_dict(symbols)
+    try:
+        t0 = time.perf_counter()
+        source = None
+        if direction in ('java_to_c', 'java_to_cpp', 'cpp_to_java'):
+            with open(filepath, 'r', encoding='utf-8') as f:
+                source = f.read()
+        elif direction == 'cpp_to_c':
+            # Bytes-native: the mapping feeds tree-sitter directly, no
+            # str decode/encode round trip for large files.
+            import cpp_to_c
+            source = cpp_to_c.load_source_bytes(filepath)
+        stages['read'] = time.perf_counter() - t0
+
+        t0 = time.perf_counter()
+        partial_dropped = None
+        try:
+            if direction == 'java_to_c':
+                import java_to_c
+                out_code = java_to_c.translate_string(source)
+            elif direction == 'java_to_cpp':
+                import java_to_cpp
+                out_code = java_to_cpp.translate_string(source)
+            elif direction == 'c_to_java':
+                import c_to_java
+                out_code = c_to_java.translate_file(filepath, symbols=symbols)
+            elif direction == 'c_to_cpp':
+                import c_to_cpp
+                out_code = c_to_cpp.translate_file(filepath, symbols=symbols)
+            elif direction == 'cpp_to_java':
+                import cpp_to_java
+                out_code = cpp_to_java.translate_string(source)
+            elif direction == 'cpp_to_c':
+                # Streamed: emitted lines go straight to out_path so large
+                # files never sit fully in memory (translate + write fuse).
+                import cpp_to_c
+                out_code = None
+                tmp_path = out_path + '.tmp'
+                t = cpp_to_c.CppToCTranslator()
+                with open(tmp_path, 'w', encoding='utf-8') as f:
+                    t.translate_stream(source, f)
+            else:
+                return (rel_path, 'ERROR', str(direction), stages)
+        except Exception:
+            # Whole-file parse failed: salvage the declarations that do
+            # parse instead of producing nothing (see partial.py).
+            if direction not in ('java_to_c', 'java_to_cpp',
+                                 'c_to_java', 'c_to_cpp'):
+                raise
+            import partial
+            if source is None:
+                with open(filepath, 'r', encoding='utf-8') as f:
+                    source = f.read()
+            salvaged = partial.retranslate(direction, source)
+            if salvaged is None:
+                raise
+            out_code, partial_dropped = salvaged
+        stages['translate'] = time.perf_counter() - t0
+
+        t0 = time.perf_counter()
+        if out_code is not None:
+            wrote = _write_if_changed(out_path, out_code)
+        else:
+            # Streamed into tmp_path; promote it only if it differs.
+            import filecmp
+            if (os.path.exists(out_path)
+                    and filecmp.cmp(tmp_path, out_path, shallow=False)):
+                os.unlink(tmp_path)
+                wrote = False
+            else:
+                os.replace(tmp_path, out_path)
+                wrote = True
+        stages['write'] = time.perf_counter() - t0
+
+        status = 'OK' if wrote else 'UNCHANGED'
+
+        if shared is not None:
+            # Publish so sibling runners get a store hit for this source.
+            import shared_cache
+            if out_code is None:
+                with open(out_path, 'rb') as f:
+                    published = f.read()
+            else:
+                published = out_code
+            shared_cache.put(shared[0], shared[1], published)
+
+        if verify:
+            t0 = time.perf_counter()
+            if out_code is None:
+                with open(out_path, 'r', encoding='utf-8') as f:
+                    out_code = f.read()
+            syntax_only = (verify == 'fast')
+            if direction in ('java_to_c', 'cpp_to_c'):
+                ok, msg = compile_c_wsl(out_code, syntax_only=syntax_only)
+            elif direction in ('c_to_java', 'cpp_to_java'):
+                ok, msg = compile_java_wsl(out_code, syntax_only=syntax_only)
+            else:  # c_to_cpp, java_to_cpp
+                ok, msg = compile_cpp_wsl(out_code, syntax_only=syntax_only)
+            stages['verify'] = time.perf_counter() - t0
+            status = 'PASS' if ok else f'FAIL: {msg}'
+
+        if partial_dropped and not status.startswith('FAIL'):
+            status = f'PARTIAL: {len(partial_dropped)} dropped'
+
+        return (rel_path, status, ARROWS[direction], stages)
+
+    except Exception as e:
+        return (rel_path, 'ERROR', str(e)[:60], stages)
+
+
+def _verify_one(args):
+    """Verifier stage of the pipeline: compile one finished output.
+
+    Runs in a thread -- the work is a compiler subprocess, so it overlaps
+    with the CPU-bound translator processes instead of blocking them.
+    """
+    rel_path, out_path, direction, verify = args
+    t0 = time.perf_counter()
+    try:
+        with open(out_path, 'r', encoding='utf-8') as f:
+            out_code = f.read()
+        syntax_only = (verify == 'fast')
+        if direction in ('java_to_c', 'cpp_to_c'):
+            ok, msg = compile_c_wsl(out_code, syntax_only=syntax_only)
+        elif direction in ('c_to_java', 'cpp_to_java'):
+            ok, msg = compile_java_wsl(out_code, syntax_only=syntax_only)
+        else:  # c_to_cpp, java_to_cpp
+            ok, msg = compile_cpp_wsl(out_code, syntax_only=syntax_only)
+        status = 'PASS' if ok else f'FAIL: {msg}'
+    except Exception as e:
+        status = f'ERROR: {str(e)[:60]}'
+    return rel_path, status, time.perf_counter() - t0
+
+
+def _run_pipeline(tasks, jobs, verify, report_cb):
+    """Producer/consumer pipeline for verified batches.
+
+    Translation workers (process pool) feed finished outputs straight
+    into a verification thread pool, so the compiler runs while the next
+    files are still translating instead of serializing the two stages
+    per file. Statuses merge into the results as verifications land.
+    """
+    out_info = {t[0]: (t[2], t[3]) for t in tasks}
+    # Workers must not verify inline; the verifier pool owns that stage.
+    stripped = [t[:4] + (False,) + t[5:] for t in tasks]
+
+    results = {}
+    with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as xlate, \
+         concurrent.futures.ThreadPoolExecutor(max_workers=max(jobs, 2)) as vpool:
+        verifying = {}
+        futures = {xlate.submit(_translate_one, t): t for t in stripped}
+        for fut in concurrent.futures.as_completed(futures):
+            rel_path, status, arrow, stages = fut.result()
+            results[rel_path] = [rel_path, status, arrow, stages]
+            if status in ('OK', 'UNCHANGED'):
+                out_path, direction = out_info[rel_path]
+                verifying[vpool.submit(
+                    _verify_one, (rel_path, out_path, direction, verify))] = rel_path
+                print(f'  [{arrow}] {rel_path} -> translated, verifying...')
+            else:
+                print(f'  [{arrow}] {rel_path} -> {status}')
+                report_cb(tuple(results[rel_path]))
+        for fut in concurrent.futures.as_completed(verifying):
+            rel_path, status, vtime = fut.result()
+            entry = results[rel_path]
+            entry[1] = status
+            entry[3]['verify'] = vtime
+            print(f'  [verify] {rel_path} -> {status.split(":")[0]}')
+            report_cb(tuple(entry))
+
+    # Results table keeps discovery order
+    return [tuple(results[t[0]]) for t in tasks]
+
+
+def _verify_outputs_batched(results, tasks):
+    """Re-verify translated outputs with one compiler invocation per language.
+
+    Collects every successfully translated output, buckets by language, and
+    calls the compile_*_batch_wsl APIs, mapping diagnostics back onto the
+    per-file results table. Replaces per-file compiler process spawns.
+    """
+    from verify import (compile_c_batch_wsl, compile_cpp_batch_wsl,
+                        compile_java_batch_wsl)
+
+    out_paths = {t[0]: t[2] for t in tasks}
+    buckets = {'.c': {}, '.cpp': {}, '.java': {}}
+    for name, status, _, _ in results:
+        if status not in ('OK', 'UNCHANGED') or name not in out_paths:
+            continue
+        out_path = out_paths[name]
+        ext = pathlib.Path(out_path).suffix.lower()
+        if ext in buckets:
+            with open(out_path, encoding='utf-8') as f:
+                buckets[ext][name] = f.read()
+
+    verdicts = {}
+    if buckets['.c']:
+        verdicts.update(compile_c_batch_wsl(buckets['.c']))
+    if buckets['.cpp']:
+        verdicts.update(compile_cpp_batch_wsl(buckets['.cpp']))
+    if buckets['.java']:
+        verdicts.update(compile_java_batch_wsl(buckets['.java']))
+
+    merged = []
+    for name, status, direction, stages in results:
+        if name in verdicts:
+            ok, msg = verdicts[name]
+            status = 'PASS' if ok else f'FAIL: {msg[:60]}'
+        merged.append((name, status, direction, stages))
+    return merged
+
+
+def _write_archive(archive_path: str, staged_dir: str) -> int:
+    """Stream every staged output into one archive, sequentially.
+
+    Tens of thousands of per-file create/close syscalls on a network
+    filesystem cost more than the translation itself; one sequential
+    writer turns that into a single streaming write. .zip and
+    .tar.gz/.tgz are picked by extension, plain tar otherwise.
+    """
+    names = []
+    for root, _dirs, files in os.walk(staged_dir):
+        for f in files:
+            if f == CACHE_FILENAME:
+                continue
+            names.append(os.path.relpath(os.path.join(root, f), staged_dir))
+    names.sort()
+
+    if archive_path.endswith('.zip'):
+        import zipfile
+        with zipfile.ZipFile(archive_path, 'w', zipfile.ZIP_DEFLATED) as z:
+            for rel in names:
+                z.write(os.path.join(staged_dir, rel), rel)
+    else:
+        import tarfile
+        mode = 'w:gz' if archive_path.endswith(('.tar.gz', '.tgz')) else 'w'
+        with tarfile.open(archive_path, mode) as t:
+            for rel in names:
+                t.add(os.path.join(staged_dir, rel), arcname=rel)
+    return len(names)
+
+
 def run_batch(folder: str, output_dir: str, to_cpp: bool,
-              verify: bool, show_ast: bool):
+              verify: bool, show_ast: bool, jobs: int = 1,
+              incremental: bool = False, verify_batch: bool = False,
+              slowest: int = 0, to_java: bool = False,
+              report: str = None, project: bool = False,
+              shard: tuple = None, cache_dir: str = None,
+              archive: str = None):
     """Translate all source files in a folder."""
     folder = os.path.abspath(folder)
     files = discover_files(folder)
+    total_discovered = len(files)
+
+    if shard:
+        files = [f for f in files
+                 if _shard_of(os.path.relpath(f, folder), shard[1]) == shard[0]]
 
     if not files:
         print(f'[WARNING] No source files found in: {folder}')
         return
 
     # Create output directory
-    if output_dir:
+    if archive:
+        # Stage outputs on local disk; the only write to the (possibly
+        # network-mounted) destination is one sequential archive below.
+        output_dir = tempfile.mkdtemp(prefix='c2java_stage_')
+    elif output_dir:
         output_dir = os.path.abspath(output_dir)
     else:
         output_dir = os.path.join(folder, 'translated')
@@ -358,24 +927,79 @@ def run_batch(folder: str, output_dir: str, to_cpp: bool,
 
     print(f'\n  Batch Mode')
     print(f'  Input     : {folder}')
-    print(f'  Output    : {output_dir}')
+    if archive:
+        print(f'  Output    : {archive} (archive, staged locally)')
+    else:
+        print(f'  Output    : {output_dir}')
+    if shard:
+        print(f'  Shard     : {shard[0]}/{shard[1]} '
+              f'({len(files)} of {total_discovered} files)')
     print(f'  Files     : {len(files)}')
     if to_cpp:
         print(f'  C target  : C++ (--to cpp)')
-    print(f'  Verify    : {"yes" if verify else "no"}')
+    if verify_batch:
+        print(f'  Verify    : batched (one compiler run per language)')
+        verify = False  # verification happens after translation instead
+    else:
+        print(f'  Verify    : {"yes" if verify else "no"}')
+    if jobs > 1:
+        print(f'  Jobs      : {jobs}')
+    if incremental:
+        print(f'  Cache     : incremental ({CACHE_FILENAME})')
+    if cache_dir:
+        print(f'  Store     : shared ({cache_dir})')
+    if report:
+        print(f'  Report    : {report} (NDJSON, streamed)')
+
+    # --project: harvest typedefs/structs/prototypes from every header
+    # once, up front; each C translation reads the shared index instead of
+    # re-deriving (or losing) cross-file type information.
+    symbols_dict = None
+    if project:
+        from symbol_index import SymbolIndex
+        headers = [f for f in files
+                   if pathlib.Path(f).suffix.lower() in ('.h', '.hpp')]
+        index = SymbolIndex.build(headers)
+        symbols_dict = index.to_dict() if len(index) else None
+        print(f'  Index     : {len(index)} symbols from '
+              f'{len(headers)} headers')
     print('=' * 60)
 
+    # --report: stream one JSON record per file as it completes, so an
+    # orchestrator can start compiling finished files mid-batch instead of
+    # scraping the summary table after the fact.
+    report_fh = open(report, 'w', encoding='utf-8') if report else None
+
+    def _report(rec):
+        if report_fh:
+            name, status, arrow, stages = rec
+            report_fh.write(json.dumps({
+                'file': name, 'direction': arrow,
+                'status': status, 'timings': stages,
+            }) + '\n')
+            report_fh.flush()
+
+    # With --output-archive the staging dir is deleted after packing, so
+    # the incremental cache must live somewhere durable: next to the
+    # archive itself.
+    cache_home = (os.path.dirname(os.path.abspath(archive))
+                  if archive else output_dir)
+    cache = _load_cache(cache_home) if incremental else {}
+    pending_keys = {}   # rel_path -> content key, recorded on success
+
     results = []
+    tasks = []
     start_time = time.time()
 
     for filepath in files:
         rel_path = os.path.relpath(filepath, folder)
         ext = pathlib.Path(filepath).suffix.lower()
         stem = pathlib.Path(filepath).stem
-        direction = get_translation_direction(ext, to_cpp)
+        direction = get_translation_direction(ext, to_cpp, to_java)
 
         if direction is None:
-            results.append((rel_path, 'SKIP', 'Unknown file type'))
+            results.append((rel_path, 'SKIP', 'Unknown file type', {}))
+            _report(results[-1])
             continue
 
         if direction == 'header':
@@ -384,9 +1008,11 @@ def run_batch(folder: str, output_dir: str, to_cpp: bool,
             os.makedirs(os.path.dirname(out_path), exist_ok=True)
             with open(filepath, 'r', encoding='utf-8') as f:
                 content = f.read()
-            with open(out_path, 'w', encoding='utf-8') as f:
-                f.write(content)
-            results.append((rel_path, 'COPY', 'Header file copied'))
+            if _write_if_changed(out_path, content):
+                results.append((rel_path, 'COPY', 'Header file copied', {}))
+            else:
+                results.append((rel_path, 'UNCHANGED', 'Header up to date', {}))
+            _report(results[-1])
             continue
 
         out_ext = get_output_ext(direction)
@@ -396,76 +1022,294 @@ def run_batch(folder: str, output_dir: str, to_cpp: bool,
         os.makedirs(out_subdir, exist_ok=True)
         out_path = os.path.join(out_subdir, stem + out_ext)
 
-        arrow = {'java_to_c': 'Java->C', 'c_to_java': 'C->Java',
-                 'c_to_cpp': 'C->C++', 'cpp_to_c': 'C++->C'}[direction]
-        print(f'\n  [{arrow}] {rel_path} -> {os.path.relpath(out_path, output_dir)}')
-
-        try:
-            if direction == 'java_to_c':
-                with open(filepath, 'r', encoding='utf-8') as f:
-                    source = f.read()
-                _, status = run_java_to_c(source, out_path, show_ast, verify, quiet=True)
-
-            elif direction == 'c_to_java':
-                _, status = run_c_to_java(filepath, out_path, show_ast, verify, quiet=True)
-
-            elif direction == 'c_to_cpp':
-                _, status = run_c_to_cpp(filepath, out_path, show_ast, verify, quiet=True)
-
-            elif direction == 'cpp_to_c':
-                with open(filepath, 'r', encoding='utf-8') as f:
-                    source = f.read()
-                _, status = run_cpp_to_c(source, out_path, show_ast, verify, quiet=True)
-
-            if status is None:
-                status = 'ERROR'
-            results.append((rel_path, status, arrow))
-            print(f'    -> {status}')
-
-        except Exception as e:
-            results.append((rel_path, 'ERROR', str(e)[:60]))
-            print(f'    -> ERROR: {e}')
+        key = None
+        if incremental or cache_dir:
+            key = _content_key(filepath, direction)
+
+        if incremental:
+            if cache.get(rel_path) == key and os.path.exists(out_path):
+                results.append((rel_path, 'CACHED', ARROWS[direction], {}))
+                _report(results[-1])
+                continue
+            pending_keys[rel_path] = key
+
+        if cache_dir:
+            # Shared store hit: a sibling runner already translated this
+            # exact source with this translator version.
+            import shared_cache
+            hit = shared_cache.get(cache_dir, key)
+            if hit is not None:
+                _write_if_changed(out_path, hit)
+                results.append((rel_path, 'CACHED', ARROWS[direction], {}))
+                _report(results[-1])
+                continue
+
+        shared = (cache_dir, key) if cache_dir else None
+        tasks.append((rel_path, filepath, out_path, direction, verify,
+                      show_ast, symbols_dict, shared))
+
+    if verify and not verify_batch and tasks:
+        # Pipelined: CPU-bound translation and subprocess-bound compilation
+        # overlap instead of alternating per file.
+        results.extend(_run_pipeline(tasks, jobs, verify, _report))
+    elif jobs > 1 and len(tasks) > 1:
+        # Fan tasks out across a process pool; each worker imports the
+        # translator modules once and handles many files.
+        task_results = {}
+        with concurrent.futures.ProcessPoolExecutor(max_workers=jobs) as pool:
+            futures = {pool.submit(_translate_one, t): t for t in tasks}
+            for fut in concurrent.futures.as_completed(futures):
+                rel_path, status, arrow, stages = fut.result()
+                task_results[rel_path] = (rel_path, status, arrow, stages)
+                print(f'  [{arrow}] {rel_path} -> {status}')
+                if not verify_batch:
+                    _report(task_results[rel_path])
+        # Keep the summary table in discovery order
+        for t in tasks:
+            results.append(task_results[t[0]])
+    else:
+        for t in tasks:
+            rel_path, filepath, out_path, direction = t[0], t[1], t[2], t[3]
+            arrow = ARROWS[direction]
+            print(f'\n  [{arrow}] {rel_path} -> {os.path.relpath(out_path, output_dir)}')
+            result = _translate_one(t)
+            results.append(result)
+            print(f'    -> {result[1]}')
+            if not verify_batch:
+                _report(result)
+
+    if verify_batch:
+        results = _verify_outputs_batched(results, tasks)
+        # Statuses only become final after the batched compile, so records
+        # for translated files are streamed here in this mode.
+        translated = {t[0] for t in tasks}
+        for r in results:
+            if r[0] in translated:
+                _report(r)
+
+    if report_fh:
+        report_fh.close()
 
     elapsed = time.time() - start_time
 
+    if incremental:
+        # Record hashes only for files that translated successfully, so
+        # failures are retried on the next run.
+        for name, status, _, _ in results:
+            # CACHED here means a shared-store hit (local incremental hits
+            # never reach pending_keys); record it so next run skips the
+            # store round-trip too.
+            if ((status in ('OK', 'PASS', 'UNCHANGED', 'CACHED')
+                    or status.startswith('PARTIAL'))
+                    and name in pending_keys):
+                cache[name] = pending_keys[name]
+        _save_cache(cache_home, cache)
+
     # Summary
     print('\n' + '=' * 60)
     print(f'  BATCH RESULTS')
     print('=' * 60)
-    print(f'  {"File":<35} {"Direction":<10} {"Status":<10}')
-    print(f'  {"-"*35} {"-"*10} {"-"*10}')
+    print(f'  {"File":<35} {"Direction":<10} {"Status":<10} {"Time":>8}')
+    print(f'  {"-"*35} {"-"*10} {"-"*10} {"-"*8}')
     passed = 0
     failed = 0
     skipped = 0
-    for name, status, direction in results:
+    for name, status, direction, stages in results:
         status_short = status if len(status) <= 10 else status[:10]
-        if status in ('OK', 'PASS'):
+        if status in ('OK', 'PASS', 'UNCHANGED'):
             passed += 1
             icon = 'v'
-        elif status in ('SKIP', 'COPY'):
+        elif status.startswith('PARTIAL'):
+            # Salvaged: output exists minus the dropped declarations
+            passed += 1
+            icon = '~'
+        elif status in ('SKIP', 'COPY', 'CACHED'):
             skipped += 1
             icon = '.'
         else:
             failed += 1
             icon = 'x'
-        print(f'  {icon} {name:<33} {direction:<10} {status_short:<10}')
+        total = sum(stages.values())
+        time_s = f'{total:.3f}s' if stages else '-'
+        print(f'  {icon} {name:<33} {direction:<10} {status_short:<10} {time_s:>8}')
 
     print(f'\n  Total: {len(results)} files | '
           f'{passed} passed | {failed} failed | {skipped} skipped | '
           f'{elapsed:.2f}s')
-    print(f'  Output: {output_dir}')
+    if archive:
+        import shutil
+        n = _write_archive(archive, output_dir)
+        shutil.rmtree(output_dir, ignore_errors=True)
+        print(f'  Output: {archive} ({n} entries)')
+    else:
+        print(f'  Output: {output_dir}')
+
+    if slowest > 0:
+        timed = sorted((r for r in results if r[3]),
+                       key=lambda r: sum(r[3].values()), reverse=True)
+        print(f'\n  SLOWEST {min(slowest, len(timed))} FILES (per-stage seconds)')
+        print(f'  {"File":<35} {"Total":>8} {"Read":>8} {"Xlate":>8} '
+              f'{"Write":>8} {"Verify":>8}')
+        for name, _, _, stages in timed[:slowest]:
+            total = sum(stages.values())
+            print(f'  {name:<35} {total:>8.3f} '
+                  f'{stages.get("read", 0):>8.3f} '
+                  f'{stages.get("translate", 0):>8.3f} '
+                  f'{stages.get("write", 0):>8.3f} '
+                  f'{stages.get("verify", 0):>8.3f}')
 
     return results
 
 
 # ---------------------------------------------------------------------------
+def run_watch(folder: str, output_dir: str, to_cpp: bool,
+              verify: bool, show_ast: bool, jobs: int = 1,
+              poll_interval: float = 0.5, to_java: bool = False):
+    """Keep a translated mirror of a folder up to date (--watch).
+
+    Runs one full incremental batch, then polls file mtimes and re-runs
+    run_batch whenever something under the folder changes. The incremental
+    content cache skips every unchanged file, and parsers stay warm in this
+    long-lived process, so latency per edit is a single file's translate
+    time rather than a full batch. Stop with Ctrl+C.
+    """
+    folder = os.path.abspath(folder)
+
+    def snapshot():
+        stamps = {}
+        for f in discover_files(folder):
+            try:
+                stamps[f] = os.stat(f).st_mtime_ns
+            except OSError:
+                pass  # deleted mid-scan; next poll catches it
+        return stamps
+
+    print(f'\n  Watch Mode (poll every {poll_interval}s, Ctrl+C to stop)')
+    run_batch(folder, output_dir, to_cpp, verify, show_ast, jobs,
+              incremental=True, to_java=to_java)
+    seen = snapshot()
+
+    try:
+        while True:
+            time.sleep(poll_interval)
+            now = snapshot()
+            if now != seen:
+                seen = now
+                print(f'\n  [watch] Change detected, re-translating...')
+                run_batch(folder, output_dir, to_cpp, verify, show_ast, jobs,
+                          incremental=True, to_java=to_java)
+    except KeyboardInterrupt:
+        print('\n  [watch] Stopped.')
+
+
+def run_pipe(argv):
+    """'-' mode: read source from stdin, write the translation to stdout.
+
+    Composing the translator into a pipeline used to require temp files
+    on both sides of every call. Here nothing touches disk: the source
+    language comes from --lang c|java|cpp (there is no extension to
+    sniff), --to cpp / --to java pick the target as in single-file mode,
+    and stdout carries only the translation -- diagnostics go to stderr.
+    """
+    def _value(flag):
+        if flag in argv and argv.index(flag) + 1 < len(argv):
+            return argv[argv.index(flag) + 1]
+        return None
+
+    lang   = _value('--lang')
+    target = _value('--to')
+    if lang not in ('c', 'java', 'cpp'):
+        print("[ERROR] '-' mode needs --lang c|java|cpp", file=sys.stderr)
+        sys.exit(1)
+
+    source = sys.stdin.read()
+    try:
+        if lang == 'java':
+            if target == 'cpp':
+                import java_to_cpp
+                out = java_to_cpp.translate_string(source)
+            else:
+                import java_to_c
+                out = java_to_c.translate_string(source)
+        elif lang == 'c':
+            # In-memory preprocessing: same bundled fake headers as
+            # translate_file, still zero disk I/O for the source. The
+            # hoisted header preamble is dropped after parsing, exactly
+            # like the file path does.
+            import preprocess, re
+            try:
+                source, n_pre = preprocess.preprocess(source)
+            except preprocess.UnsupportedDirective:
+                # Needs a real preprocessor; pipe mode has no gcc -E
+                # fallback, so strip directives like translate_file's
+                # last resort does.
+                source = re.sub(r'//.*?$|/\*.*?\*/', '', source,
+                                flags=re.M | re.S)
+                source = '\n'.join(l for l in source.splitlines()
+                                   if not l.strip().startswith('#'))
+                n_pre = 0
+            if target == 'cpp':
+                import c_to_cpp
+                out = c_to_cpp.translate_preprocessed(source, n_pre)
+            else:
+                import c_to_java
+                out = c_to_java.translate_preprocessed(source, n_pre)
+        else:  # cpp
+            if target == 'java':
+                import cpp_to_java
+                out = cpp_to_java.translate_string(source)
+            else:
+                import cpp_to_c
+                out = cpp_to_c.translate_string(source)
+    except Exception as e:
+        print(f'[ERROR] {e}', file=sys.stderr)
+        sys.exit(1)
+
+    sys.stdout.write(out)
+    if not out.endswith('\n'):
+        sys.stdout.write('\n')
+
+
 def main():
+    argv = sys.argv[1:]
+
+    # ── Pipe mode: nothing but the translation may reach stdout ───────────────
+    if '-' in argv:
+        run_pipe(argv)
+        return
+
     print(BANNER)
-    argv       = sys.argv[1:]
     show_ast   = '--ast'    in argv
-    verify     = '--verify' in argv
+    verify     = 'fast' if '--verify-fast' in argv else ('--verify' in argv)
     demo_mode  = '--demo'   in argv
     to_cpp     = '--to' in argv and 'cpp' in argv
+    to_java    = '--to' in argv and 'java' in argv
+
+    # --profile: per-node-type visit counters on every translator class;
+    # the ranked table prints at exit, after whichever mode ran.
+    if '--profile' in argv:
+        import profiler
+        profiler.enable()
+    incremental = '--incremental' in argv
+    verify_batch = '--verify-batch' in argv
+
+    # --verify-session: route compile_*_wsl calls through one long-lived
+    # WSL shell instead of booting the subsystem per compile.
+    if '--verify-session' in argv:
+        import verify
+        verify.enable_persistent_session()
+
+    # ── Daemon mode: load parsers once, serve jobs until stopped ──────────────
+    if '--daemon' in argv:
+        import daemon
+        if '--port' in argv:
+            idx = argv.index('--port')
+            port = (int(argv[idx + 1]) if idx + 1 < len(argv)
+                    else daemon.DEFAULT_PORT)
+            daemon.serve_socket(port)
+        else:
+            daemon.serve_stdio()
+        return
 
     # Parse --output DIR
     output_dir = None
@@ -474,9 +1318,88 @@ def main():
         if idx + 1 < len(argv):
             output_dir = argv[idx + 1]
 
+    # ── Shard merge mode: combine per-machine reports and caches ──────────────
+    if '--merge-shards' in argv:
+        idx = argv.index('--merge-shards')
+        paths = argv[idx + 1:]
+        if len(paths) < 2:
+            print('[ERROR] --merge-shards expects OUT.ndjson IN1.ndjson ...')
+            sys.exit(1)
+        run_merge_shards(paths[0], paths[1:])
+        return
+
+    # Parse --shard i/N
+    shard = None
+    shard_arg = None
+    if '--shard' in argv:
+        idx = argv.index('--shard')
+        if idx + 1 < len(argv):
+            shard_arg = argv[idx + 1]
+            try:
+                i, n = (int(x) for x in shard_arg.split('/'))
+                if not (1 <= i <= n):
+                    raise ValueError
+                shard = (i, n)
+            except ValueError:
+                print(f'[ERROR] --shard expects i/N with 1 <= i <= N, '
+                      f'got: {shard_arg}')
+                sys.exit(1)
+
+    # Parse --cache-dir DIR (shared content-addressed store)
+    import shared_cache
+    cache_dir = shared_cache.default_dir()
+    cache_dir_arg = None
+    if '--cache-dir' in argv:
+        idx = argv.index('--cache-dir')
+        if idx + 1 < len(argv):
+            cache_dir_arg = argv[idx + 1]
+            cache_dir = cache_dir_arg
+
+    # Parse --output-archive FILE (.tar/.tar.gz/.zip)
+    archive = None
+    if '--output-archive' in argv:
+        idx = argv.index('--output-archive')
+        if idx + 1 < len(argv):
+            archive = argv[idx + 1]
+
+    # Parse --report FILE.ndjson
+    report = None
+    if '--report' in argv:
+        idx = argv.index('--report')
+        if idx + 1 < len(argv):
+            report = argv[idx + 1]
+
+    # Parse --slowest N
+    slowest = 0
+    slowest_arg = None
+    if '--slowest' in argv:
+        idx = argv.index('--slowest')
+        if idx + 1 < len(argv):
+            slowest_arg = argv[idx + 1]
+            try:
+                slowest = max(0, int(slowest_arg))
+            except ValueError:
+                print(f'[ERROR] --slowest expects a number, got: {slowest_arg}')
+                sys.exit(1)
+
+    # Parse --jobs N
+    jobs = 1
+    jobs_arg = None
+    if '--jobs' in argv:
+        idx = argv.index('--jobs')
+        if idx + 1 < len(argv):
+            jobs_arg = argv[idx + 1]
+            try:
+                jobs = max(1, int(jobs_arg))
+            except ValueError:
+                print(f'[ERROR] --jobs expects a number, got: {jobs_arg}')
+                sys.exit(1)
+
     files = [a for a in argv
              if not a.startswith('--') and a not in ('cpp', 'java', 'c')
-             and a != output_dir]
+             and a != output_dir and a != jobs_arg and a != slowest_arg
+             and a != report and a != shard_arg and a != cache_dir_arg
+             and a != archive]
 
     # ── Interactive / demo mode ───────────────────────────────────────────────
     if not files or demo_mode:
@@ -498,7 +1421,15 @@ def main():
 
     # ── Folder batch mode ─────────────────────────────────────────────────────
     if os.path.isdir(path):
-        run_batch(path, output_dir, to_cpp, verify, show_ast)
+        if '--watch' in argv:
+            run_watch(path, output_dir, to_cpp, verify, show_ast, jobs,
+                      to_java=to_java)
+        else:
+            run_batch(path, output_dir, to_cpp, verify, show_ast, jobs,
+                      incremental=incremental, verify_batch=verify_batch,
+                      slowest=slowest, to_java=to_java, report=report,
+                      project='--project' in argv, shard=shard,
+                      cache_dir=cache_dir, archive=archive)
         return
 
     # ── Single file mode ──────────────────────────────────────────────────────
@@ -508,19 +1439,25 @@ def main():
     if ext == '.java':
         with open(path, encoding='utf-8') as f: source = f.read()
         print(f'Input: {path}')
-        run_java_to_c(source, stem + '.c', show_ast, verify)
+        if to_cpp:
+            run_java_to_cpp(source, stem + '.cpp', show_ast, verify)
+        else:
+            run_java_to_c(source, stem + '.c', show_ast, verify)
 
     elif ext == '.c':
         print(f'Input: {path}')
         if to_cpp:
             run_c_to_cpp(path, stem + '.cpp', show_ast, verify)
         else:
-            run_c_to_java(path, stem + '.java', show_ast, verify)
+            run_c_to_java(path, stem + '.java', show_ast, verify, jobs=jobs)
 
     elif ext == '.cpp':
         with open(path, encoding='utf-8') as f: source = f.read()
         print(f'Input: {path}')
-        run_cpp_to_c(source, stem + '.c', show_ast, verify)
+        if to_java:
+            run_cpp_to_java(source, stem + '.java', show_ast, verify)
+        else:
+            run_cpp_to_c(source, stem + '.c', show_ast, verify)
 
     else:
         print(f'[ERROR] Unsupported extension "{ext}". Use .java, .c, or .cpp')
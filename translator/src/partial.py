@@ -0,0 +1,173 @@
+# =============================================================================
+#  partial.py  -- per-declaration salvage when a whole-file parse fails
+#
+#  When pycparser or javalang throws, batch mode used to mark the whole
+#  file ERROR and retry it from scratch on every run. For a 10k-line
+#  generated file where one exotic construct fails, that throws away 99%
+#  of perfectly translatable output. retranslate() splits the source into
+#  top-level declarations with a brace scanner, grows a prefix of
+#  declarations that still parse, drops the ones that don't, translates
+#  the surviving source in one call and records exactly which
+#  declarations were dropped (as trailing // comments in the output and
+#  in the batch status).
+#
+#  The prefix-growing check re-parses O(n^2) source in the worst case,
+#  but it only runs on the failure path that previously produced nothing.
+# =============================================================================
+
+import re
+
+_MAX_DESC = 60
+
+
+def split_units(text):
+    """Split text into top-level units: each unit ends at a ';' or at the
+    '}' closing a depth-0 brace group ('};' for structs). The scanner
+    skips braces inside strings, chars and comments."""
+    units = []
+    start = 0
+    depth = 0
+    i, n = 0, len(text)
+    while i < n:
+        ch = text[i]
+        if ch == '/' and i + 1 < n and text[i + 1] == '/':
+            i = text.find('\n', i)
+            i = n if i < 0 else i
+            continue
+        if ch == '/' and i + 1 < n and text[i + 1] == '*':
+            j = text.find('*/', i + 2)
+            i = n if j < 0 else j + 2
+            continue
+        if ch in '"\'':
+            j = i + 1
+            while j < n and text[j] != ch:
+                j += 2 if text[j] == '\\' else 1
+            i = j + 1
+            continue
+        if ch == '{':
+            depth += 1
+        elif ch == '}':
+            depth -= 1
+            if depth == 0:
+                # Consume an immediately following ';' (struct/typedef)
+                j = i + 1
+                while j < n and text[j] in ' \t':
+                    j += 1
+                if j < n and text[j] == ';':
+                    i = j
+                units.append(text[start:i + 1])
+                start = i + 1
+                i += 1
+                continue
+        elif ch == ';' and depth == 0:
+            units.append(text[start:i + 1])
+            start = i + 1
+            i += 1
+            continue
+        i += 1
+    tail = text[start:]
+    if tail.strip():
+        units.append(tail)
+    return units
+
+
+def _describe(unit):
+    """Short label for a dropped unit: its first non-empty line."""
+    for line in unit.splitlines():
+        if line.strip():
+            line = line.strip()
+            return line if len(line) <= _MAX_DESC else line[:_MAX_DESC] + '...'
+    return '<empty>'
+
+
+def _grow_prefix(units, check, header='', footer=''):
+    """Keep each unit whose addition to the good prefix still parses.
+
+    Returns (good_units, dropped_descriptions); None when nothing was
+    dropped (the failure is not isolable to a unit) or nothing survived.
+    """
+    good, dropped = [], []
+    for unit in units:
+        candidate = header + '\n'.join(good + [unit]) + footer
+        try:
+            check(candidate)
+            good.append(unit)
+        except Exception:
+            dropped.append(_describe(unit))
+    if not dropped or not good:
+        return None
+    return good, dropped
+
+
+def _salvage_c(source, check):
+    """C sources: units are the top-level declarations themselves."""
+    units = split_units(source)
+    if len(units) < 2:
+        return None
+    grown = _grow_prefix(units, check)
+    if grown is None:
+        return None
+    good, dropped = grown
+    return '\n'.join(good), dropped
+
+
+def _salvage_java(source, check):
+    """Java sources: the file is one class, so units are the members at
+    brace depth 1 -- the class header and closing brace are kept and each
+    candidate is re-wrapped in them."""
+    open_idx = source.find('{')
+    close_idx = source.rfind('}')
+    if open_idx < 0 or close_idx <= open_idx:
+        return None
+    header = source[:open_idx + 1] + '\n'
+    footer = '\n' + source[close_idx:]
+    units = split_units(source[open_idx + 1:close_idx])
+    if len(units) < 2:
+        return None
+    grown = _grow_prefix(units, check, header, footer)
+    if grown is None:
+        return None
+    good, dropped = grown
+    return header + '\n'.join(good) + footer, dropped
+
+
+def retranslate(direction, source):
+    """Salvage a source whose whole-file translation threw.
+
+    Returns (out_code, dropped_descriptions) or None when salvage is not
+    possible for this direction/source. out_code ends with one comment
+    line per dropped declaration so the loss is visible in the output.
+    """
+    if direction in ('c_to_java', 'c_to_cpp'):
+        import ast_cache
+        # Same normalization as the backends' strip-includes fallback
+        source = re.sub(r'//.*?$|/\*.*?\*/', '', source, flags=re.M | re.S)
+        source = '\n'.join(l for l in source.splitlines()
+                           if not l.strip().startswith('#'))
+        salvaged = _salvage_c(source, ast_cache.parse_string)
+        if salvaged is None:
+            return None
+        good_source, dropped = salvaged
+        if direction == 'c_to_java':
+            import c_to_java
+            out = c_to_java.translate_string(good_source)
+        else:
+            import c_to_cpp
+            out = c_to_cpp.translate_string(good_source)
+    elif direction in ('java_to_c', 'java_to_cpp'):
+        import javalang
+        salvaged = _salvage_java(source, javalang.parse.parse)
+        if salvaged is None:
+            return None
+        good_source, dropped = salvaged
+        if direction == 'java_to_c':
+            import java_to_c
+            out = java_to_c.translate_string(good_source)
+        else:
+            import java_to_cpp
+            out = java_to_cpp.translate_string(good_source)
+    else:
+        return None  # tree-sitter directions never throw on parse
+
+    footer = ''.join(f'// [partial] dropped: {d}\n' for d in dropped)
+    return out + '\n' + footer, dropped
@@ -0,0 +1,198 @@
+# =============================================================================
+#  preprocess.py  -- pure-Python preprocessing with bundled fake headers
+#
+#  pycparser can't parse raw C with #includes, so translate_file() used to
+#  shell out to gcc -E for every file, re-expanding the same standard
+#  headers each time -- subprocess spawn plus header expansion is the
+#  single largest fixed cost per C file. This layer ships minimal fake
+#  libc headers (fake_headers/), expands includes and object-like macros
+#  in-process, and caches the preprocessed text keyed by the source bytes
+#  plus a hash of the bundled header set, so hot runs never touch a
+#  subprocess at all.
+#
+#  Scope matches what the translator accepts downstream: include-once
+#  expansion and object-like #define substitution outside string
+#  literals. Anything fancier -- conditionals, function-like macros,
+#  #undef -- raises UnsupportedDirective so the callers' except clauses
+#  actually fall through to the gcc -E path instead of translating a
+#  silently-mangled file.
+# =============================================================================
+
+import os, re, hashlib, tempfile, functools
+
+FAKE_DIR = os.path.join(os.path.dirname(__file__), 'fake_headers')
+
+CACHE_DIR = os.environ.get(
+    'C2JAVA_CPP_CACHE',
+    os.path.join(tempfile.gettempdir(), 'c2java_cpp_cache'))
+
+_INCLUDE_RE = re.compile(r'#\s*include\s*[<"]([^>"]+)[>"]')
+_DEFINE_RE  = re.compile(r'#\s*define\s+(\w+)(?:[ \t]+(.*))?$')
+_FN_DEFINE_RE = re.compile(r'#\s*define\s+(\w+)\(')
+_STRING_RE  = re.compile(r'("(?:\\.|[^"\\])*"|\'(?:\\.|[^\'\\])*\')')
+_DIRECTIVE_RE = re.compile(r'#\s*(\w+)')
+
+# Directives whose meaning we cannot honor by dropping the line: keeping
+# both branches of a conditional (or collecting #defines from mutually
+# exclusive branches) silently changes the program.
+_UNSUPPORTED = frozenset(
+    ('if', 'ifdef', 'ifndef', 'elif', 'else', 'endif', 'undef'))
+
+
+class UnsupportedDirective(ValueError):
+    """The source needs a real preprocessor; callers fall back to gcc -E."""
+
+
+def _strip_comments(text):
+    return re.sub(r'//.*?$|/\*.*?\*/', '', text, flags=re.M | re.S)
+
+
+@functools.lru_cache(maxsize=1)
+def _header_set_hash():
+    """Digest of every bundled header, so editing one invalidates the
+    preprocessing cache."""
+    h = hashlib.sha256()
+    for name in sorted(os.listdir(FAKE_DIR)):
+        h.update(name.encode('utf-8'))
+        with open(os.path.join(FAKE_DIR, name), 'rb') as f:
+            h.update(f.read())
+    return h.hexdigest()
+
+
+def _expand(text, include_dirs, seen, defines, header_out, body_out):
+    """One pass: hoist include expansions into header_out, keep the file's
+    own lines in body_out, collect object-like defines, drop all other
+    directives."""
+    for line in _strip_comments(text).splitlines():
+        stripped = line.strip()
+        if not stripped.startswith('#'):
+            body_out.append(line)
+            continue
+        m = _INCLUDE_RE.match(stripped)
+        if m:
+            name = m.group(1)
+            if name in seen:
+                continue
+            for d in include_dirs:
+                path = os.path.join(d, name)
+                if os.path.isfile(path):
+                    seen.add(name)
+                    with open(path, encoding='utf-8') as f:
+                        # A header's own lines (and its nested includes)
+                        # all belong to the hoisted preamble
+                        _expand(f.read(), include_dirs, seen, defines,
+                                header_out, header_out)
+                    break
+            # Unresolvable headers drop silently, like the strip fallback
+            continue
+        m = _FN_DEFINE_RE.match(stripped)
+        if m:
+            # Function-like: dropping it would leave un-expanded call
+            # sites behind, so refuse instead
+            raise UnsupportedDirective(f'function-like macro: {m.group(1)}')
+        m = _DEFINE_RE.match(stripped)
+        if m:
+            if m.group(2) is not None:
+                defines[m.group(1)] = m.group(2).strip()
+            continue
+        d = _DIRECTIVE_RE.match(stripped)
+        if d and d.group(1) in _UNSUPPORTED:
+            raise UnsupportedDirective(f'#{d.group(1)}')
+        # Anything left (#pragma, #error text, ...) drops harmlessly
+    return body_out
+
+
+def _apply_defines(text, defines):
+    """Substitute object-like macros outside string/char literals, then
+    iterate so macros referencing macros resolve."""
+    if not defines:
+        return text
+    pattern = re.compile(
+        r'\b(' + '|'.join(re.escape(k) for k in defines) + r')\b')
+    for _ in range(5):   # bounded fixpoint; real chains are 1-2 deep
+        changed = False
+        parts = _STRING_RE.split(text)
+        for i, part in enumerate(parts):
+            if i % 2:            # string/char literal: leave untouched
+                continue
+            new = pattern.sub(lambda m: defines[m.group(1)], part)
+            if new != part:
+                parts[i] = new
+                changed = True
+        text = ''.join(parts)
+        if not changed:
+            break
+    return text
+
+
+def preprocess(source, include_dirs=()):
+    """Preprocess C source text using the bundled fake headers.
+
+    Returns (text, n_preamble): the first n_preamble lines of text are
+    the hoisted header expansions. Callers drop declarations on those
+    lines after parsing -- the same line-count trick _parse_with_symbols
+    uses -- so header scaffolding never reaches emission. Object-like
+    macro substitution never changes line counts, so the split survives
+    _apply_defines.
+    """
+    defines = {}
+    header, body = [], []
+    _expand(source, list(include_dirs) + [FAKE_DIR], set(), defines,
+            header, body)
+    text = _apply_defines('\n'.join(header + body), defines)
+    return text, len(header)
+
+
+def _local_header_hash(text, include_dir, h, seen):
+    """Fold every include resolvable next to the file (recursively) into
+    the digest. Bundled headers are covered by _header_set_hash, but
+    project-local headers are inlined during expansion too, so an edit to
+    one must invalidate the cached preprocessed text."""
+    for m in _INCLUDE_RE.finditer(text):
+        name = m.group(1)
+        path = os.path.join(include_dir, name)
+        if name in seen or not os.path.isfile(path):
+            continue
+        seen.add(name)
+        with open(path, 'rb') as f:
+            data = f.read()
+        h.update(name.encode('utf-8'))
+        h.update(data)
+        _local_header_hash(data.decode('utf-8', 'replace'),
+                           include_dir, h, seen)
+
+
+def preprocess_file(c_path):
+    """Preprocess a C file, with on-disk caching.
+
+    Quoted project headers resolve relative to the file's directory; the
+    cache key covers the source bytes, the bundled header set, and the
+    contents of every resolvable local header, and the cache is
+    best-effort like ast_cache's. Returns (text, n_preamble) like
+    preprocess(); the cache file stores the preamble line count on its
+    first line.
+    """
+    with open(c_path, 'rb') as f:
+        data = f.read()
+    h = hashlib.sha256(data + _header_set_hash().encode('utf-8'))
+    _local_header_hash(data.decode('utf-8', 'replace'),
+                       os.path.dirname(c_path) or '.', h, set())
+    key = h.hexdigest()
+    cache_path = os.path.join(CACHE_DIR, key + '.i')
+    try:
+        with open(cache_path, encoding='utf-8') as f:
+            first, text = f.read().split('\n', 1)
+            return text, int(first)
+    except (OSError, ValueError):
+        pass
+    text, n_pre = preprocess(data.decode('utf-8'),
+                             include_dirs=[os.path.dirname(c_path) or '.'])
+    try:
+        os.makedirs(CACHE_DIR, exist_ok=True)
+        tmp = cache_path + f'.{os.getpid()}.tmp'
+        with open(tmp, 'w', encoding='utf-8') as f:
+            f.write(f'{n_pre}\n{text}')
+        os.replace(tmp, cache_path)
+    except OSError:
+        pass
+    return text, n_pre
@@ -0,0 +1,85 @@
+# =============================================================================
+#  profiler.py  -- per-node-type visitor profiling (--profile)
+#
+#  When a file translates slowly there was no visibility into which visitor
+#  is hot. enable() instruments the per-node dispatch point of all four
+#  translator classes with visit counts and cumulative time per node type,
+#  and registers a ranked report to print at exit. Cumulative time includes
+#  time spent in child nodes, so parent node types naturally rank above the
+#  leaves they contain.
+#
+#  Usage:  uv run python src/main.py input.c --profile
+# =============================================================================
+
+import sys, os, time, atexit
+
+sys.path.insert(0, os.path.dirname(__file__))
+
+_counts = {}   # (class name, node type) -> [count, cumulative seconds]
+_enabled = False
+
+
+def _record(cls_name, node_type, dt):
+    slot = _counts.get((cls_name, node_type))
+    if slot is None:
+        _counts[(cls_name, node_type)] = [1, dt]
+    else:
+        slot[0] += 1
+        slot[1] += dt
+
+
+def _wrap(cls, method_name, type_key):
+    """Replace cls.method with a timing wrapper. type_key extracts the
+    node-type label from the method's first argument."""
+    original = getattr(cls, method_name)
+
+    def timed(self, node, *args, **kwargs):
+        t0 = time.perf_counter()
+        try:
+            return original(self, node, *args, **kwargs)
+        finally:
+            _record(cls.__name__, type_key(node), time.perf_counter() - t0)
+
+    timed.__name__ = method_name
+    setattr(cls, method_name, timed)
+
+
+def enable():
+    """Instrument all four translator classes; idempotent."""
+    global _enabled
+    if _enabled:
+        return
+    _enabled = True
+
+    py_type = lambda node: type(node).__name__   # pycparser / javalang nodes
+    ts_type = lambda node: node.type             # tree-sitter nodes
+
+    import c_to_java
+    _wrap(c_to_java.CToJavaVisitor, 'visit', py_type)
+
+    import c_to_cpp
+    _wrap(c_to_cpp.CToCppVisitor, 'visit', py_type)
+
+    import java_to_c
+    _wrap(java_to_c.JavaToCVisitor, '_stmt', py_type)
+    _wrap(java_to_c.JavaToCVisitor, '_expr', py_type)
+
+    import cpp_to_c
+    _wrap(cpp_to_c.CppToCTranslator, '_top_level', ts_type)
+    _wrap(cpp_to_c.CppToCTranslator, '_stmt', ts_type)
+
+    atexit.register(report)
+
+
+def report(top=25):
+    """Print visit counts and cumulative time, ranked by time."""
+    if not _counts:
+        return
+    print('\n' + '=' * 60)
+    print('  PROFILE (per node type, ranked by cumulative time)')
+    print('=' * 60)
+    print(f'  {"Visitor":<18} {"Node type":<22} {"Count":>7} {"Time":>9}')
+    print(f'  {"-"*18} {"-"*22} {"-"*7} {"-"*9}')
+    ranked = sorted(_counts.items(), key=lambda kv: kv[1][1], reverse=True)
+    for (cls_name, node_type), (count, total) in ranked[:top]:
+        print(f'  {cls_name:<18} {node_type:<22} {count:>7} {total:>8.4f}s')
@@ -0,0 +1,75 @@
+# =============================================================================
+#  rules.py  -- shared rewrite-rule engine for type and call mapping
+#
+#  Type and library-call mapping used to be scattered per-node string
+#  work: the clang backend re-ran the same spelling surgery for every
+#  cursor, and each backend kept its own dict-plus-fallback helpers. The
+#  engine compiles a backend's mappings once into flat tables:
+#
+#    TypeRules  -- base type names plus memoized resolution of derived
+#                  spellings (const/restrict qualifiers, pointers, sized
+#                  and 2D arrays), so the string surgery for any given
+#                  spelling happens at most once per process.
+#    CallRules  -- unary/binary library-call rewrites in one flat table
+#                  keyed by callee name.
+#
+#  Backends keep their TYPE_MAP/STRING_FUNC_* dicts as the rule source;
+#  the engine is the single place that knows how to apply them.
+# =============================================================================
+
+
+class TypeRules:
+    """Memoized type mapping compiled from a base name table.
+
+    Pointer/array derivation ('T *' -> mapped T plus '[]', the char*
+    special case) encodes Java array semantics, so it is opt-in via
+    derive=True. Backends that only map base names (c_to_cpp) leave it
+    off: a pointer spelling then falls through unchanged instead of
+    silently picking up Java syntax in C++ output.
+    """
+
+    def __init__(self, base, derive=False, char_pointer=None):
+        self._base = dict(base)
+        self._derive = derive
+        # char* is special in Java-targeting backends: it is a String,
+        # not a char[] like other pointers.
+        self._char_pointer = char_pointer
+        self._memo = {}
+
+    def map(self, spelling):
+        try:
+            return self._memo[spelling]
+        except KeyError:
+            result = self._resolve(spelling)
+            self._memo[spelling] = result
+            return result
+
+    def _resolve(self, spelling):
+        if not self._derive:
+            return self._base.get(spelling, spelling)
+        s = spelling.replace('const ', '').replace('restrict ', '').strip()
+        if self._char_pointer is not None and s == 'char *':
+            return self._char_pointer
+        if s.endswith(' *'):
+            return self.map(s[:-2].strip()) + '[]'
+        if s.count('[') >= 2:
+            return self.map(s[:s.index('[')].strip()) + '[][]'
+        if '[' in s:
+            return self.map(s[:s.index('[')].strip()) + '[]'
+        return self._base.get(s, s)
+
+
+class CallRules:
+    """Library-call rewrites, flattened by callee name and arity."""
+
+    def __init__(self, unary=None, binary=None):
+        self._unary = dict(unary or {})
+        self._binary = dict(binary or {})
+
+    def apply(self, name, args):
+        """Rewritten call text, or None when no rule matches."""
+        if name in self._unary and args:
+            return self._unary[name](args[0])
+        if name in self._binary and len(args) >= 2:
+            return self._binary[name](args[0], args[1])
+        return None
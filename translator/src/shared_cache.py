@@ -0,0 +1,54 @@
+# =============================================================================
+#  shared_cache.py  -- content-addressed translation store (--cache-dir)
+#
+#  The per-run incremental cache only helps the machine that wrote it;
+#  sibling CI runners re-translate inputs their neighbours already did.
+#  This store keeps finished translations on a shared mount, keyed by the
+#  same content key as --incremental (source hash + direction + translator
+#  version), so a hit on any machine turns translation into a file copy.
+#
+#  Layout is git-style two-level fan-out (key[:2]/key) to keep directory
+#  listings sane at fleet scale. All operations are best-effort: a flaky
+#  mount degrades to a normal translation, never a failed one. Writes go
+#  through a temp file + os.replace so concurrent publishers of the same
+#  key are safe.
+# =============================================================================
+
+import os, tempfile
+
+STORE_ENV = 'C2JAVA_SHARED_CACHE'
+
+
+def default_dir():
+    """Shared store location from the environment, if configured."""
+    return os.environ.get(STORE_ENV)
+
+
+def _entry_path(cache_dir, key):
+    return os.path.join(cache_dir, key[:2], key)
+
+
+def get(cache_dir, key):
+    """Return the stored translation text for key, or None on miss."""
+    try:
+        with open(_entry_path(cache_dir, key), encoding='utf-8') as f:
+            return f.read()
+    except (OSError, ValueError):
+        return None
+
+
+def put(cache_dir, key, text):
+    """Publish a finished translation; silently a no-op on any failure."""
+    if isinstance(text, str):
+        text = text.encode('utf-8')
+    entry = _entry_path(cache_dir, key)
+    try:
+        os.makedirs(os.path.dirname(entry), exist_ok=True)
+        fd, tmp = tempfile.mkstemp(dir=os.path.dirname(entry))
+        try:
+            os.write(fd, text)
+        finally:
+            os.close(fd)
+        os.replace(tmp, entry)
+    except (OSError, ValueError):
+        pass
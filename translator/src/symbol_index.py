@@ -0,0 +1,83 @@
+# =============================================================================
+#  symbol_index.py  -- shared cross-file symbol index for batch mode
+#
+#  Batch mode copies headers verbatim and translates each .c file on its
+#  own, so every file that includes project headers used to fail the
+#  fake-libc parse and lose the shared typedefs/structs/prototypes in the
+#  strip-includes fallback. A SymbolIndex scans all headers once per batch
+#  with lightweight regexes (no preprocessor run), and its preamble() is
+#  prepended to each file's fallback parse so cross-file types resolve.
+#
+#  The index is a plain dict-of-dicts so it pickles cleanly into --jobs
+#  worker processes via the task tuples.
+# =============================================================================
+
+import re
+
+# typedef ... name;  (covers  typedef struct {...} name;  via DOTALL body)
+_TYPEDEF_RE   = re.compile(
+    r'typedef\s+(?:struct|union|enum)?\s*\w*\s*(?:\{.*?\})?\s*'
+    r'[\w\s\*]*?(\w+)\s*;', re.S)
+# struct Name { ... };
+_STRUCT_RE    = re.compile(r'\b(struct|union|enum)\s+(\w+)\s*\{.*?\}\s*;', re.S)
+# ret name(args);  -- prototypes only, body-less
+_PROTOTYPE_RE = re.compile(
+    r'^[ \t]*((?:[\w\*]+[ \t\*]+)+(\w+)[ \t]*\([^;{)]*\))[ \t]*;',
+    re.M)
+
+
+def _strip_comments(text):
+    return re.sub(r'//.*?$|/\*.*?\*/', '', text, flags=re.M | re.S)
+
+
+class SymbolIndex:
+    """Function signatures, struct/union/enum layouts and typedefs
+    harvested from a batch's header files."""
+
+    def __init__(self, typedefs=None, structs=None, functions=None):
+        self.typedefs  = typedefs  or {}   # name -> full typedef text
+        self.structs   = structs   or {}   # name -> full definition text
+        self.functions = functions or {}   # name -> prototype text
+
+    @classmethod
+    def build(cls, header_paths):
+        """Scan headers once; later declarations win on name collisions,
+        matching the include-order behaviour of a real preprocessor."""
+        index = cls()
+        for path in header_paths:
+            try:
+                with open(path, encoding='utf-8') as f:
+                    text = _strip_comments(f.read())
+            except OSError:
+                continue
+            for m in _TYPEDEF_RE.finditer(text):
+                index.typedefs[m.group(1)] = m.group(0)
+            for m in _STRUCT_RE.finditer(text):
+                index.structs[m.group(2)] = m.group(0)
+            for m in _PROTOTYPE_RE.finditer(text):
+                index.functions[m.group(2)] = m.group(1) + ';'
+        return index
+
+    def __len__(self):
+        return len(self.typedefs) + len(self.structs) + len(self.functions)
+
+    def preamble(self):
+        """C declaration text to prepend before parsing a source file.
+
+        Order matters: typedefs first (struct bodies may use them), then
+        struct definitions, then prototypes.
+        """
+        parts = (list(self.typedefs.values())
+                 + [s for n, s in self.structs.items()]
+                 + list(self.functions.values()))
+        return '\n'.join(parts)
+
+    def to_dict(self):
+        return {'typedefs': self.typedefs, 'structs': self.structs,
+                'functions': self.functions}
+
+    @classmethod
+    def from_dict(cls, d):
+        if not d:
+            return None
+        return cls(d.get('typedefs'), d.get('structs'), d.get('functions'))
@@ -4,18 +4,166 @@
 
 import subprocess
 import tempfile
+import threading
+import shlex
 import os
 
 
-def compile_c_wsl(c_source: str) -> tuple[bool, str]:
+# ---------------------------------------------------------------------------
+#  Persistent compiler session
+#
+#  Spawning 'wsl' boots the subsystem per call (~1s on Windows runners).
+#  A CompilerSession keeps one long-lived WSL shell alive and feeds it
+#  compile commands over stdin, so per-call overhead drops to the cost of
+#  the compiler itself. Enable with enable_persistent_session(); all
+#  compile_*_wsl calls then route through the shared session.
+# ---------------------------------------------------------------------------
+
+class CompilerSession:
+    """One long-lived WSL shell that compile commands are piped into."""
+
+    _RC_MARKER = '__VERIFY_RC__'
+
+    def __init__(self, shell_cmd=('wsl', 'sh')):
+        self._cmd  = list(shell_cmd)
+        self._proc = None
+        self._lock = threading.Lock()
+
+    def _ensure(self):
+        if self._proc is None or self._proc.poll() is not None:
+            self._proc = subprocess.Popen(
+                self._cmd,
+                stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                stderr=subprocess.STDOUT, text=True, bufsize=1,
+            )
+
+    def run(self, command: str, timeout: int = 30):
+        """Run one shell command; returns (returncode or None, output)."""
+        with self._lock:
+            try:
+                self._ensure()
+            except FileNotFoundError:
+                return None, 'WSL not found. Is WSL installed?'
+            proc = self._proc
+            # Watchdog: kill the shell if the compiler wedges; the next
+            # call re-spawns it via _ensure().
+            timer = threading.Timer(timeout, proc.kill)
+            timer.start()
+            lines = []
+            try:
+                proc.stdin.write(f'{command} 2>&1; echo "{self._RC_MARKER}$?"\n')
+                proc.stdin.flush()
+                while True:
+                    line = proc.stdout.readline()
+                    if not line:  # killed or EOF
+                        return None, '\n'.join(lines) or 'Compiler session terminated.'
+                    line = line.rstrip('\n')
+                    if line.startswith(self._RC_MARKER):
+                        try:
+                            rc = int(line[len(self._RC_MARKER):])
+                        except ValueError:
+                            rc = 1
+                        return rc, '\n'.join(lines)
+                    lines.append(line)
+            except (OSError, ValueError):
+                return None, 'Compiler session write failed.'
+            finally:
+                timer.cancel()
+
+    def close(self):
+        if self._proc is not None and self._proc.poll() is None:
+            try:
+                self._proc.stdin.close()
+                self._proc.wait(timeout=5)
+            except (OSError, subprocess.TimeoutExpired):
+                self._proc.kill()
+        self._proc = None
+
+
+_session = None
+_use_session = False
+
+
+def enable_persistent_session(on: bool = True):
+    """Route all compile_*_wsl calls through one long-lived WSL shell."""
+    global _use_session
+    _use_session = on
+    if not on:
+        close_session()
+
+
+def close_session():
+    global _session
+    if _session is not None:
+        _session.close()
+        _session = None
+
+
+def _run_compiler(cmd: list, timeout: int, tool: str) -> tuple[int, str] | tuple[None, str]:
+    """Run a ['wsl', compiler, ...] command, via the persistent session
+    when enabled, else as a one-shot subprocess. Returns (rc, output)."""
+    global _session
+    if _use_session:
+        if _session is None:
+            _session = CompilerSession()
+        # Drop the 'wsl' prefix: the session shell already runs inside WSL.
+        command = ' '.join(shlex.quote(a) for a in cmd[1:])
+        return _session.run(command, timeout=timeout)
+    try:
+        result = subprocess.run(cmd, capture_output=True, text=True,
+                                timeout=timeout)
+        return result.returncode, (result.stdout + result.stderr).strip()
+    except FileNotFoundError:
+        return None, 'WSL not found. Is WSL installed?'
+    except subprocess.TimeoutExpired:
+        return None, f'{tool} timed out.'
+
+
+def _compile_via_pipe(source: str, cmd: list, timeout: int, tool: str):
+    """Stream source to the compiler over stdin -- no temp file at all.
+
+    Returns (rc, msg); rc is None when the pipe path could not run and the
+    caller should fall back to the temp-file path.
+    """
+    try:
+        result = subprocess.run(cmd, input=source, capture_output=True,
+                                text=True, timeout=timeout)
+        return result.returncode, (result.stdout + result.stderr).strip()
+    except FileNotFoundError:
+        return None, 'WSL not found. Is WSL installed?'
+    except (subprocess.TimeoutExpired, OSError):
+        return None, f'{tool} timed out.'
+
+
+def compile_c_wsl(c_source: str, syntax_only: bool = False) -> tuple[bool, str]:
     """
     Compile a C source string using WSL gcc.
 
+    The fast path streams the source over stdin ('gcc -x c -'), avoiding
+    the temp-file round trip entirely; the temp-file path remains as a
+    fallback and for the persistent session, which is line-oriented.
+
+    syntax_only=True runs gcc -fsyntax-only: parsing and type checking
+    without codegen or linking, which is several times faster and enough
+    for the usual "does the translation compile" question. Use the full
+    compile when you need the stronger check.
+
     Returns:
         (success: bool, message: str)
         success=True  -> compiled cleanly
         success=False -> compile errors returned in message
     """
+    if not _use_session:
+        if syntax_only:
+            cmd = ['wsl', 'gcc', '-Wall', '-fsyntax-only', '-x', 'c', '-']
+        else:
+            cmd = ['wsl', 'gcc', '-Wall', '-x', 'c', '-', '-o', '/dev/null']
+        rc, msg = _compile_via_pipe(c_source, cmd, timeout=15, tool='gcc')
+        if rc is not None:
+            return rc == 0, msg or 'Compiled successfully.'
+        if msg.startswith('WSL not found'):
+            return False, msg
+
     with tempfile.NamedTemporaryFile(
         suffix='.c', mode='w', encoding='utf-8',
         delete=False, dir=tempfile.gettempdir()
@@ -27,18 +175,15 @@ def compile_c_wsl(c_source: str) -> tuple[bool, str]:
     wsl_path = _win_to_wsl(c_path)
     out_path  = wsl_path.replace('.c', '.out')
 
-    cmd = ['wsl', 'gcc', '-Wall', '-o', out_path, wsl_path]
+    if syntax_only:
+        cmd = ['wsl', 'gcc', '-Wall', '-fsyntax-only', wsl_path]
+    else:
+        cmd = ['wsl', 'gcc', '-Wall', '-o', out_path, wsl_path]
     try:
-        result = subprocess.run(
-            cmd, capture_output=True, text=True, timeout=15
-        )
-        ok  = result.returncode == 0
-        msg = (result.stdout + result.stderr).strip()
-        return ok, msg or 'Compiled successfully.'
-    except FileNotFoundError:
-        return False, 'WSL not found. Is WSL installed?'
-    except subprocess.TimeoutExpired:
-        return False, 'gcc timed out.'
+        rc, msg = _run_compiler(cmd, timeout=15, tool='gcc')
+        if rc is None:
+            return False, msg
+        return rc == 0, msg or 'Compiled successfully.'
     finally:
         try: os.unlink(c_path)
         except OSError: pass
@@ -60,10 +205,14 @@ def compile_c_file_wsl(c_path: str) -> tuple[bool, str]:
         return compile_c_wsl(f.read())
 
 
-def compile_java_wsl(java_source: str) -> tuple[bool, str]:
+def compile_java_wsl(java_source: str, syntax_only: bool = False) -> tuple[bool, str]:
     """
     Compile a Java source string using WSL javac.
 
+    javac has no -fsyntax-only equivalent; syntax_only disables
+    annotation processing (-proc:none), which is the cheapest tier
+    javac offers, and otherwise behaves like the full compile.
+
     Returns:
         (success: bool, message: str)
     """
@@ -77,18 +226,12 @@ def compile_java_wsl(java_source: str) -> tuple[bool, str]:
 
     wsl_path = _win_to_wsl(java_path)
 
-    cmd = ['wsl', 'javac', wsl_path]
+    cmd = ['wsl', 'javac', '-proc:none', wsl_path] if syntax_only else ['wsl', 'javac', wsl_path]
     try:
-        result = subprocess.run(
-            cmd, capture_output=True, text=True, timeout=30
-        )
-        ok  = result.returncode == 0
-        msg = (result.stdout + result.stderr).strip()
-        return ok, msg or 'Compiled successfully.'
-    except FileNotFoundError:
-        return False, 'WSL not found. Is WSL installed?'
-    except subprocess.TimeoutExpired:
-        return False, 'javac timed out.'
+        rc, msg = _run_compiler(cmd, timeout=30, tool='javac')
+        if rc is None:
+            return False, msg
+        return rc == 0, msg or 'Compiled successfully.'
     finally:
         # Clean up temp files
         import glob
@@ -99,13 +242,167 @@ def compile_java_wsl(java_source: str) -> tuple[bool, str]:
         except OSError: pass
 
 
-def compile_cpp_wsl(cpp_source: str) -> tuple[bool, str]:
+# ---------------------------------------------------------------------------
+#  Batch verification: one compiler invocation for many sources
+# ---------------------------------------------------------------------------
+
+def _parse_diagnostics(stderr: str, names: list) -> dict:
+    """Group 'file:line:col: ...' compiler diagnostics by source basename."""
+    per_file = {name: [] for name in names}
+    for line in stderr.splitlines():
+        for name in names:
+            if line.startswith(name + ':') or f'/{name}:' in line:
+                per_file[name].append(line)
+                break
+    return per_file
+
+
+def _compile_batch(sources: dict, suffix: str, compiler_cmd: list,
+                   timeout: int = 60) -> dict:
+    """
+    Compile many sources with a single compiler invocation.
+
+    sources: {name: source_code} -- name is used for diagnostics mapping.
+    Returns {name: (success, message)}.
+    """
+    import shutil
+    tmp_dir = tempfile.mkdtemp(prefix='batchv_')
+    paths = {}
+    try:
+        for i, (name, code) in enumerate(sources.items()):
+            fname = f'u{i}_{os.path.basename(name)}'
+            if not fname.endswith(suffix):
+                fname += suffix
+            path = os.path.join(tmp_dir, fname)
+            with open(path, 'w', encoding='utf-8') as f:
+                f.write(code)
+            paths[fname] = name
+
+        cmd = compiler_cmd + sorted(paths)
+        try:
+            result = subprocess.run(
+                cmd, capture_output=True, text=True,
+                timeout=timeout, cwd=tmp_dir
+            )
+        except FileNotFoundError:
+            return {name: (False, 'Compiler not found.') for name in sources}
+        except subprocess.TimeoutExpired:
+            return {name: (False, 'Compiler timed out.') for name in sources}
+
+        diags = _parse_diagnostics(result.stdout + result.stderr, sorted(paths))
+        out = {}
+        for fname, name in paths.items():
+            lines = diags.get(fname, [])
+            has_error = any(': error' in l or ': fatal error' in l for l in lines)
+            if result.returncode == 0 or not has_error:
+                out[name] = (True, '\n'.join(lines) or 'Compiled successfully.')
+            else:
+                out[name] = (False, '\n'.join(lines))
+        return out
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
+def compile_c_batch_wsl(sources: dict) -> dict:
+    """Compile many C sources in one WSL gcc invocation (compile-only)."""
+    return _compile_batch(sources, '.c', ['wsl', 'gcc', '-Wall', '-c'])
+
+
+def compile_cpp_batch_wsl(sources: dict) -> dict:
+    """Compile many C++ sources in one WSL g++ invocation (compile-only)."""
+    return _compile_batch(sources, '.cpp',
+                          ['wsl', 'g++', '-Wall', '-std=c++17', '-c'])
+
+
+def compile_java_batch(sources: dict, javac_cmd=None,
+                       syntax_only: bool = False, timeout: int = 120) -> dict:
+    """
+    Verify many Java sources with ONE javac invocation (one JVM boot).
+
+    Every generated file declares 'public class Main', so they cannot
+    share an invocation as-is (duplicate class in the unnamed package).
+    Each source is therefore staged under a unique class name -- a
+    whole-word rewrite of the Main identifier, which also renames any
+    Main.xxx static references consistently -- and all staged files
+    compile in a single javac run, with diagnostics attributed per file.
+
+    javac_cmd defaults to a local ['javac']; pass ['wsl', 'javac'] for
+    the WSL path. Returns {name: (success, message)}.
+    """
+    import re, shutil
+    javac_cmd = list(javac_cmd or ['javac'])
+    if syntax_only:
+        javac_cmd.append('-proc:none')
+    main_re = re.compile(r'\bMain\b')
+    tmp_dir = tempfile.mkdtemp(prefix='batchj_')
+    staged = {}   # staged file name -> original name
+    try:
+        for i, (name, code) in enumerate(sources.items()):
+            cls = f'Main_{i}'
+            fname = cls + '.java'
+            with open(os.path.join(tmp_dir, fname), 'w',
+                      encoding='utf-8') as f:
+                f.write(main_re.sub(cls, code))
+            staged[fname] = name
+
+        cmd = javac_cmd + sorted(staged)
+        try:
+            result = subprocess.run(
+                cmd, capture_output=True, text=True,
+                timeout=timeout, cwd=tmp_dir
+            )
+        except FileNotFoundError:
+            return {name: (False, 'Compiler not found.') for name in sources}
+        except subprocess.TimeoutExpired:
+            return {name: (False, 'Compiler timed out.') for name in sources}
+
+        diags = _parse_diagnostics(result.stdout + result.stderr,
+                                   sorted(staged))
+        out = {}
+        for fname, name in staged.items():
+            lines = diags.get(fname, [])
+            has_error = any(': error' in l for l in lines)
+            if result.returncode == 0 or not has_error:
+                out[name] = (True, '\n'.join(lines) or 'Compiled successfully.')
+            else:
+                out[name] = (False, '\n'.join(lines))
+        return out
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
+def compile_java_batch_wsl(sources: dict) -> dict:
+    """Verify many Java sources in one WSL javac invocation (one JVM
+    boot for the whole batch; see compile_java_batch for the class-name
+    staging that makes a shared invocation legal)."""
+    return compile_java_batch(sources, javac_cmd=['wsl', 'javac'])
+
+
+def compile_cpp_wsl(cpp_source: str, syntax_only: bool = False) -> tuple[bool, str]:
     """
     Compile a C++ source string using WSL g++.
 
+    Streams the source over stdin ('g++ -x c++ -') when possible, falling
+    back to the temp-file path (see compile_c_wsl).
+
+    syntax_only=True runs g++ -fsyntax-only (no codegen, no link).
+
     Returns:
         (success: bool, message: str)
     """
+    if not _use_session:
+        if syntax_only:
+            cmd = ['wsl', 'g++', '-Wall', '-std=c++17', '-fsyntax-only',
+                   '-x', 'c++', '-']
+        else:
+            cmd = ['wsl', 'g++', '-Wall', '-std=c++17', '-x', 'c++', '-',
+                   '-o', '/dev/null']
+        rc, msg = _compile_via_pipe(cpp_source, cmd, timeout=15, tool='g++')
+        if rc is not None:
+            return rc == 0, msg or 'Compiled successfully.'
+        if msg.startswith('WSL not found'):
+            return False, msg
+
     with tempfile.NamedTemporaryFile(
         suffix='.cpp', mode='w', encoding='utf-8',
         delete=False, dir=tempfile.gettempdir()
@@ -116,18 +413,15 @@ def compile_cpp_wsl(cpp_source: str) -> tuple[bool, str]:
     wsl_path = _win_to_wsl(cpp_path)
     out_path = wsl_path.replace('.cpp', '.out')
 
-    cmd = ['wsl', 'g++', '-Wall', '-std=c++17', '-o', out_path, wsl_path]
+    if syntax_only:
+        cmd = ['wsl', 'g++', '-Wall', '-std=c++17', '-fsyntax-only', wsl_path]
+    else:
+        cmd = ['wsl', 'g++', '-Wall', '-std=c++17', '-o', out_path, wsl_path]
     try:
-        result = subprocess.run(
-            cmd, capture_output=True, text=True, timeout=15
-        )
-        ok  = result.returncode == 0
-        msg = (result.stdout + result.stderr).strip()
-        return ok, msg or 'Compiled successfully.'
-    except FileNotFoundError:
-        return False, 'WSL not found. Is WSL installed?'
-    except subprocess.TimeoutExpired:
-        return False, 'g++ timed out.'
+        rc, msg = _run_compiler(cmd, timeout=15, tool='g++')
+        if rc is None:
+            return False, msg
+        return rc == 0, msg or 'Compiled successfully.'
     finally:
         try: os.unlink(cpp_path)
         except OSError: pass
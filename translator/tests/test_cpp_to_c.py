@@ -214,3 +214,20 @@ def test_const():
     out = t(src)
     assert 'const' in out
     assert '100' in out
+
+# ── incremental re-translation ────────────────────────────────────────────────
+
+def test_incremental_matches_full():
+    src = "#include <iostream>\nint add(int a, int b) { return a + b; }\nint main() { return 0; }\n"
+    sess = cpp_to_c.IncrementalTranslator()
+    assert sess.update(src) == t(src)
+
+def test_incremental_edit():
+    v1 = "int add(int a, int b) { return a + b; }\nint main() { return 0; }\n"
+    v2 = "int add(int a, int b) { return a - b; }\nint main() { return 0; }\n"
+    sess = cpp_to_c.IncrementalTranslator()
+    sess.update(v1)
+    edit = {'start_byte': 33, 'old_end_byte': 34, 'new_end_byte': 34,
+            'start_point': (0, 33), 'old_end_point': (0, 34),
+            'new_end_point': (0, 34)}
+    assert sess.update(v2, edits=[edit]) == t(v2)
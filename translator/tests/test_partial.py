@@ -0,0 +1,60 @@
+# tests/test_partial.py
+# Tests for per-declaration salvage when a whole-file parse fails
+import sys, os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'src'))
+from partial import split_units, _salvage_c, _salvage_java
+
+C_SRC = """\
+int add(int a, int b) { return a + b; }
+struct P { int x; };
+int bad(int x) { return @@; }
+int mul(int a, int b) { return a * b; }
+int g;
+"""
+
+JAVA_SRC = """\
+public class Main {
+    static int ok(int x) { return x; }
+    static int bad(int x) { return @@; }
+    public static void main(String[] args) { }
+}
+"""
+
+
+def _check(src):
+    # Stand-in parser: rejects anything containing the bad marker
+    if '@@' in src:
+        raise ValueError('parse error')
+
+
+def test_split_top_level_units():
+    units = split_units(C_SRC)
+    assert len(units) == 5
+    assert units[1].strip() == 'struct P { int x; };'
+    assert units[4].strip() == 'int g;'
+
+
+def test_split_ignores_braces_in_strings_and_comments():
+    src = ('char *s = "{{{";\n'
+           'int f() { /* } */ return 1; } // }\n'
+           'int h() { return 2; }\n')
+    assert len(split_units(src)) == 3
+
+
+def test_salvage_c_drops_only_bad_decl():
+    good, dropped = _salvage_c(C_SRC, _check)
+    assert '@@' not in good
+    assert 'int add' in good and 'int mul' in good and 'int g;' in good
+    assert dropped == ['int bad(int x) { return @@; }']
+
+
+def test_salvage_c_none_when_everything_parses():
+    assert _salvage_c('int a;\nint b;\n', _check) is None
+
+
+def test_salvage_java_keeps_class_wrapper():
+    good, dropped = _salvage_java(JAVA_SRC, _check)
+    assert good.startswith('public class Main {')
+    assert good.rstrip().endswith('}')
+    assert '@@' not in good and 'static int ok' in good
+    assert len(dropped) == 1
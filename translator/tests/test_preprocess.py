@@ -0,0 +1,100 @@
+# tests/test_preprocess.py
+# Tests for the bundled fake-header preprocessor
+import sys, os, pytest
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'src'))
+import preprocess
+
+SRC = """\
+#include <stdio.h>
+#include <stdlib.h>
+#define SIZE 10
+#define DOUBLE (SIZE * 2)
+int main() {
+    int arr[SIZE];
+    int d = DOUBLE;
+    char *s = "SIZE stays";
+    printf("%d\\n", d);
+    return EXIT_SUCCESS;
+}
+"""
+
+
+def test_standard_headers_expand_in_process():
+    out, _ = preprocess.preprocess(SRC)
+    assert 'int printf(' in out
+    assert 'void *malloc(' in out
+    assert '#' not in out
+
+
+def test_object_macros_substitute_and_chain():
+    out, _ = preprocess.preprocess(SRC)
+    assert 'int arr[10];' in out
+    assert 'int d = (10 * 2);' in out
+    assert 'return 0;' in out          # EXIT_SUCCESS
+
+
+def test_macros_leave_string_literals_alone():
+    out, _ = preprocess.preprocess(SRC)
+    assert '"SIZE stays"' in out
+
+
+def test_quoted_includes_resolve_next_to_file(tmp_path):
+    (tmp_path / 'local.h').write_text('int helper(int x);\n')
+    c = tmp_path / 'prog.c'
+    c.write_text('#include "local.h"\nint main() { return helper(1); }\n')
+    out, n_pre = preprocess.preprocess_file(str(c))
+    assert 'int helper(int x);' in out
+
+
+def test_headers_expand_once():
+    # stdio.h and stdlib.h both pull in _common.h; its typedefs must not
+    # duplicate or pycparser would reject the redefinition
+    out, _ = preprocess.preprocess(SRC)
+    assert out.count('typedef unsigned long size_t;') == 1
+
+
+def test_header_expansion_hoists_into_counted_preamble():
+    # Every expanded header line must sit above n_preamble so the
+    # backends can drop the scaffolding by source line; the user's own
+    # code must all land below it
+    out, n_pre = preprocess.preprocess(SRC)
+    lines = out.splitlines()
+    preamble, body = lines[:n_pre], lines[n_pre:]
+    assert any('int printf(' in l for l in preamble)
+    assert not any('int printf(' in l for l in body)
+    assert any('int main()' in l for l in body)
+    assert not any('int main()' in l for l in preamble)
+
+
+def test_preprocess_file_caches(tmp_path):
+    c = tmp_path / 'a.c'
+    c.write_text('#include <math.h>\nint main() { return M_PI > 3; }\n')
+    first = preprocess.preprocess_file(str(c))
+    assert preprocess.preprocess_file(str(c)) == first
+
+
+def test_conditionals_raise_for_gcc_fallback():
+    # Keeping both branches of a conditional would silently change the
+    # program; the callers' except clauses must get a chance to fall
+    # back to gcc -E instead
+    src = '#ifdef FAST\nint x = 1;\n#else\nint x = 2;\n#endif\n'
+    with pytest.raises(preprocess.UnsupportedDirective):
+        preprocess.preprocess(src)
+
+
+def test_function_like_macros_raise_for_gcc_fallback():
+    src = '#define SQ(x) ((x)*(x))\nint y = SQ(3);\n'
+    with pytest.raises(preprocess.UnsupportedDirective):
+        preprocess.preprocess(src)
+
+
+def test_editing_local_header_invalidates_cache(tmp_path):
+    # Local headers are inlined, so their bytes are part of the cache key
+    (tmp_path / 'local.h').write_text('int helper(int x);\n')
+    c = tmp_path / 'prog.c'
+    c.write_text('#include "local.h"\nint main() { return helper(1); }\n')
+    out, _ = preprocess.preprocess_file(str(c))
+    assert 'int helper(int x);' in out
+    (tmp_path / 'local.h').write_text('long helper(long x);\n')
+    out, _ = preprocess.preprocess_file(str(c))
+    assert 'long helper(long x);' in out
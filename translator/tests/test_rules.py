@@ -0,0 +1,61 @@
+# tests/test_rules.py
+# Tests for the shared rewrite-rule engine (TypeRules / CallRules)
+import sys, os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'src'))
+from rules import TypeRules, CallRules
+
+BASE = {'int': 'int', 'double': 'double', 'char': 'char', '_Bool': 'boolean'}
+
+
+def test_base_lookup_and_identity_fallback():
+    tr = TypeRules(BASE)
+    assert tr.map('int') == 'int'
+    assert tr.map('_Bool') == 'boolean'
+    assert tr.map('struct Point') == 'struct Point'
+
+
+def test_pointer_and_array_derivation():
+    tr = TypeRules(BASE, derive=True)
+    assert tr.map('int *') == 'int[]'
+    assert tr.map('double[10]') == 'double[]'
+    assert tr.map('int[2][3]') == 'int[][]'
+
+
+def test_char_pointer_special_case():
+    tr = TypeRules(BASE, derive=True, char_pointer='String')
+    assert tr.map('char *') == 'String'
+    assert tr.map('const char *') == 'String'
+    # without the special case, char* falls through to the pointer rule
+    assert TypeRules(BASE, derive=True).map('char *') == 'char[]'
+
+
+def test_qualifiers_are_stripped():
+    tr = TypeRules(BASE, derive=True)
+    assert tr.map('const int') == 'int'
+    assert tr.map('const int *restrict ') == 'int[]'
+
+
+def test_resolution_is_memoized():
+    tr = TypeRules(BASE, derive=True)
+    tr.map('int *')
+    assert tr._memo['int *'] == 'int[]'
+    # derived lookups memoize the intermediate spellings too
+    assert tr._memo['int'] == 'int'
+
+
+def test_derivation_is_opt_in():
+    # c_to_cpp maps base names only; pointer spellings must pass through
+    # rather than silently becoming Java array types
+    tr = TypeRules(BASE)
+    assert tr.map('int') == 'int'
+    assert tr.map('int *') == 'int *'
+    assert tr.map('char[10]') == 'char[10]'
+
+
+def test_call_rules_arity_and_miss():
+    cr = CallRules(unary={'strlen': lambda s: f'{s}.length()'},
+                   binary={'strcmp': lambda a, b: f'{a}.compareTo({b})'})
+    assert cr.apply('strlen', ['s']) == 's.length()'
+    assert cr.apply('strcmp', ['a', 'b']) == 'a.compareTo(b)'
+    assert cr.apply('strlen', []) is None
+    assert cr.apply('printf', ['x']) is None
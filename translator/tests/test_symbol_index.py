@@ -0,0 +1,58 @@
+# tests/test_symbol_index.py
+# Tests for the batch-mode shared symbol index (--project)
+import sys, os
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '..', 'src'))
+from symbol_index import SymbolIndex
+
+HEADER = """\
+// geometry header
+typedef struct { int x; int y; } Point;
+typedef unsigned long usize;
+struct Node { int val; struct Node *next; };
+int dist(Point a, Point b);
+void free_list(struct Node *head);
+#define MAX 10
+"""
+
+
+def _build(tmp_path, text=HEADER):
+    h = tmp_path / 'geom.h'
+    h.write_text(text)
+    return SymbolIndex.build([str(h)])
+
+
+def test_harvests_all_kinds(tmp_path):
+    idx = _build(tmp_path)
+    assert set(idx.typedefs) == {'Point', 'usize'}
+    assert set(idx.structs) == {'Node'}
+    assert set(idx.functions) == {'dist', 'free_list'}
+    assert len(idx) == 5
+
+
+def test_preamble_order_and_content(tmp_path):
+    pre = _build(tmp_path).preamble()
+    # typedefs come before the prototypes that use them
+    assert pre.index('Point;') < pre.index('int dist')
+    assert 'struct Node' in pre
+    assert '#define' not in pre
+
+
+def test_dict_roundtrip(tmp_path):
+    idx = _build(tmp_path)
+    again = SymbolIndex.from_dict(idx.to_dict())
+    assert again.preamble() == idx.preamble()
+    assert SymbolIndex.from_dict(None) is None
+
+
+def test_later_headers_win(tmp_path):
+    a = tmp_path / 'a.h'
+    a.write_text('int f(int x);\n')
+    b = tmp_path / 'b.h'
+    b.write_text('int f(int x, int y);\n')
+    idx = SymbolIndex.build([str(a), str(b)])
+    assert idx.functions['f'] == 'int f(int x, int y);'
+
+
+def test_missing_header_skipped(tmp_path):
+    idx = SymbolIndex.build([str(tmp_path / 'absent.h')])
+    assert len(idx) == 0